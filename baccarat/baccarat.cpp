@@ -12,13 +12,18 @@
 #define BET_PANDA                   5
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(baccarat)
+    struct baccarat_config: baccarat_round_config {
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] EZ Baccarat win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] EZ Baccarat lose!";
+    };
 
     class baccarat_result {
     public:
         vector<card_t> banker_cards, player_cards;
         uint8_t banker_point, player_point;
-        const uint8_t*  payout_array;
+        static constexpr uint8_t BET_TYPES = BET_PANDA + 1;
+        payout_table<BET_TYPES, 1> payouts;
         uint8_t result;
         uint8_t roundResult;
 
@@ -34,28 +39,39 @@ namespace godapp {
         baccarat_result(random& random_gen) {
             draw_cards(banker_cards, banker_point, player_cards, player_point, random_gen);
 
-            result = 0;
+            result = get_result(banker_point, banker_cards.size(), player_point, player_cards.size());
+            roundResult = result;
+            payouts.fill<baccarat::bet>([&](const baccarat::bet& bet_item) {
+                return outcome_payout(result - 1, bet_item);
+            });
+        }
+
+        static uint8_t get_result(uint8_t banker_point, size_t banker_count, uint8_t player_point, size_t player_count) {
             if (player_point > banker_point) {
-                if (player_point == 8 && player_cards.size() == 3) {
-                    result = BET_PANDA;
-                } else {
-                    result = BET_PLAYER_WIN;
-                }
+                return (player_point == 8 && player_count == 3) ? BET_PANDA : BET_PLAYER_WIN;
             } else if (banker_point > player_point) {
-                if (banker_point == 7 && banker_cards.size() == 3) {
-                    result = BET_DRAGON;
-                } else {
-                    result = BET_BANKER_WIN;
-                }
+                return (banker_point == 7 && banker_count == 3) ? BET_DRAGON : BET_BANKER_WIN;
             } else {
-                result = BET_TIE;
+                return BET_TIE;
             }
-            roundResult = result;
-            payout_array = PAYOUT_MATRIX[result - 1];
         }
 
         asset get_payout(const baccarat::bet& bet_item) {
-            return bet_item.bet * payout_array[bet_item.bet_type - 1];
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        // one outcome per result, in PAYOUT_MATRIX order
+        static constexpr size_t OUTCOMES = 5;
+
+        static asset outcome_payout(size_t outcome, const baccarat::bet& bet_item) {
+            if (bet_item.bet_type < BET_BANKER_WIN || bet_item.bet_type > BET_PANDA) {
+                return bet_item.bet * 0;
+            }
+            return bet_item.bet * PAYOUT_MATRIX[outcome][bet_item.bet_type - 1];
+        }
+
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            return outcome_worst_payout<baccarat_result, baccarat::bet>(stakes);
         }
 
         string result_string() {
@@ -92,5 +108,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(baccarat, EZ Baccarat, baccarat_result, 1)
+    DEFINE_ROUND_GAME(baccarat)
 };
\ No newline at end of file
@@ -14,14 +14,19 @@ namespace godapp {
     using namespace eosio;
     using namespace std;
 
-    CONTRACT baccarat: public contract {
+    class baccarat_result;
+    struct baccarat_config;
+
+    CONTRACT baccarat: public round_game<baccarat, baccarat_result, baccarat_config> {
         public:
         DEFINE_GLOBAL_TABLE
+        DEFINE_COUNTERS_TABLE
         DEFINE_GAMES_TABLE(vector<card_t> player_cards; vector<card_t> banker_cards;)
         DEFINE_BETS_TABLE
+        DEFINE_ROUND_RISK_TABLE
+        DEFINE_SETTLEMENT_TABLE
         DEFINE_RESULTS_TABLE
         DEFINE_HISTORY_TABLE
-        DEFINE_BET_AMOUNT_TABLE
         DEFINE_RANDOM_KEY_TABLE
 
         ACTION receipt(uint64_t game_id, capi_checksum256 seed, string player_cards, uint8_t player_point,
@@ -7,23 +7,17 @@
 #define card_t uint16_t
 #include "../common/cards.hpp"
 
-#define G_ID_START                  101
-#define G_ID_RESULT_ID              101
-#define G_ID_GAME_ID                102
-#define G_ID_BET_ID                 103
-#define G_ID_HISTORY_ID             104
-#define G_ID_END                    104
-
-#define GAME_LENGTH                 45
-#define GAME_RESOLVE_TIME           15
-
-#define RESULT_SIZE                 100
-#define HISTORY_SIZE                100
-
 #define NUM_CARDS                   52 * 8
 
 
 namespace godapp {
+    // round constants shared by EZ Baccarat and Baccarat Classic
+    struct baccarat_round_config {
+        static constexpr uint32_t GAME_LENGTH = 45;
+        static constexpr uint64_t RESULT_SIZE = 100;
+        static constexpr uint64_t HISTORY_SIZE = 100;
+    };
+
     uint8_t card_point(card_t card) {
         uint8_t value = card_value(card);
         return value > 9 ? 0 : value;
@@ -59,28 +53,28 @@ namespace godapp {
     void draw_cards(std::vector<card_t>& banker_cards, uint8_t& banker_point,
                     std::vector<card_t>& player_cards, uint8_t& player_point,
                     random& random_gen) {
-        std::vector<card_t> cards;
+        card_deck deck(NUM_CARDS);
 
-        add_card(random_gen, banker_cards, cards, NUM_CARDS);
-        add_card(random_gen, player_cards, cards, NUM_CARDS);
+        deck.add_card(random_gen, banker_cards);
+        deck.add_card(random_gen, player_cards);
 
-        add_card(random_gen, banker_cards, cards, NUM_CARDS);
-        add_card(random_gen, player_cards, cards, NUM_CARDS);
+        deck.add_card(random_gen, banker_cards);
+        deck.add_card(random_gen, player_cards);
 
         banker_point = cards_point(banker_cards);
         player_point = cards_point(player_cards);
 
         if (banker_point < 8 && player_point < 8) {
             if (player_point < 6) {
-                uint8_t player_third_card = card_point(add_card(random_gen, player_cards, cards, NUM_CARDS));
+                uint8_t player_third_card = card_point(deck.add_card(random_gen, player_cards));
                 player_point = cards_point(player_cards);
 
                 if (banker_draw_third_card(banker_point, player_third_card)) {
-                    add_card(random_gen, banker_cards, cards, NUM_CARDS);
+                    deck.add_card(random_gen, banker_cards);
                     banker_point = cards_point(banker_cards);
                 }
             } else if (banker_point < 6) {
-                add_card(random_gen, banker_cards, cards, NUM_CARDS);
+                deck.add_card(random_gen, banker_cards);
                 banker_point = cards_point(banker_cards);
             }
         }
@@ -90,11 +90,10 @@ namespace godapp {
         return (uint8_t) random_gen.generator(NUM_CARDS);
 	}
 
-    void blackjack::transfer(name from, name to, asset quantity, string memo) {
-	    if (!check_transfer(this, from, to, quantity, memo)) {
-	        return;
-        }
-	    transfer_to_house(_self, quantity, from, quantity.amount);
+    DEFINE_ROUTED_TRANSFER(blackjack)
+
+    void blackjack::doBet(name from, asset quantity, const string& memo, bool routed) {
+	    accept_bet(_self, routed, quantity, from, quantity.amount);
 
 	    param_reader reader(memo);
 	    uint8_t action = reader.next_param_i("action is missing");
@@ -87,14 +87,16 @@ namespace godapp {
         ACTION hardclose(uint64_t game_id, string reason);
         ACTION cleargames(uint32_t num);
         ACTION transfer(name from, name to, asset quantity, string memo);
+        ACTION placebet(name player, asset quantity, string memo);
         ACTION pay(game_item gm, string banker_cards, string player_cards, asset payout);
 
     private:
         void make_action(uint64_t id, uint8_t action);
         void close(uint64_t id, random& random_gen);
+        void doBet(name from, asset quantity, const string& memo, bool routed);
     };
 
-    EOSIO_ABI_EX(blackjack, (init)(resolve)(playeraction)(hardclose)(cleargames)(setglobal)(transfer)(pay))
+    EOSIO_ABI_EX(blackjack, (init)(resolve)(playeraction)(hardclose)(cleargames)(setglobal)(transfer)(placebet)(pay))
 }
 
 
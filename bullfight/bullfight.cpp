@@ -5,19 +5,6 @@
 #include "../house/house.hpp"
 #include "../common/cards.hpp"
 
-#define G_ID_START                  101
-#define G_ID_RESULT_ID              101
-#define G_ID_GAME_ID                102
-#define G_ID_BET_ID                 103
-#define G_ID_HISTORY_ID             104
-#define G_ID_END                    104
-
-#define GAME_LENGTH                 45
-#define GAME_RESOLVE_TIME           25
-
-#define RESULT_SIZE                 100
-#define HISTORY_SIZE                100
-
 #define NUM_CARDS                   52
 
 #define  NO_BULL        0
@@ -36,7 +23,14 @@
 #define  SMALL_BULL     13
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(bullfight)
+    struct bullfight_config {
+        static constexpr uint32_t GAME_LENGTH = 45;
+        static constexpr uint64_t RESULT_SIZE = 100;
+        static constexpr uint64_t HISTORY_SIZE = 100;
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] Bull Fight win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] Bull Fight lose!";
+    };
 
     class bullfight_result {
     public:
@@ -47,13 +41,30 @@ namespace godapp {
         int64_t player1_rate, player2_rate, player3_rate, player4_rate;
         uint64_t result = 0;
         uint8_t roundResult = 0;
+        static constexpr uint8_t BET_TYPES = 5;
+        payout_table<BET_TYPES, 5> payouts;
 
         bullfight_result(random &random_gen) {
             draw_cards(random_gen);
+            payouts.fill<bullfight::bet>([&](const bullfight::bet &bet_item) {
+                return (5 + get_pay_rate(bet_item.bet_type)) * bet_item.bet / 5;
+            });
         }
 
         asset get_payout(const bullfight::bet &bet_item) {
-            return (5 + get_pay_rate(bet_item.bet_type)) * bet_item.bet / 5;
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        // the hands are dealt independently, the worst case is every player hand beating the banker with a
+        // small bull
+        static constexpr size_t OUTCOMES = 1;
+
+        static asset outcome_payout(size_t outcome, const bullfight::bet &bet_item) {
+            return (5 + get_hand_pay_rate(SMALL_BULL)) * bet_item.bet / 5;
+        }
+
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            return outcome_worst_payout<bullfight_result, bullfight::bet>(stakes);
         }
 
         uint64_t get_pay_rate(uint8_t bet_type) {
@@ -258,5 +269,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(bullfight, Bull Fight, bullfight_result, 1)
+    DEFINE_ROUND_GAME(bullfight)
 };
\ No newline at end of file
@@ -14,9 +14,13 @@ namespace godapp {
     using namespace eosio;
     using namespace std;
 
-    CONTRACT bullfight: public contract {
+    class bullfight_result;
+    struct bullfight_config;
+
+    CONTRACT bullfight: public round_game<bullfight, bullfight_result, bullfight_config> {
     public:
         DEFINE_GLOBAL_TABLE
+        DEFINE_COUNTERS_TABLE
         DEFINE_GAMES_TABLE(
             std::vector<card_t> banker_cards;
             std::vector<card_t> player1_cards;
@@ -25,9 +29,10 @@ namespace godapp {
             std::vector<card_t> player4_cards;
         )
         DEFINE_BETS_TABLE
+        DEFINE_ROUND_RISK_TABLE
+        DEFINE_SETTLEMENT_TABLE
         DEFINE_RESULTS_TABLE
         DEFINE_HISTORY_TABLE
-        DEFINE_BET_AMOUNT_TABLE
         DEFINE_RANDOM_KEY_TABLE
 
         ACTION receipt(uint64_t game_id, capi_checksum256 seed, string banker_cards, string player1_cards,
@@ -11,7 +11,11 @@
 #define BET_PLAYER_PAIR             16
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(cbaccarat)
+    struct cbaccarat_config: baccarat_round_config {
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] Baccarat Classic win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] Baccarat Classic lose!";
+    };
 
     class cbaccarat_result {
     public:
@@ -21,6 +25,8 @@ namespace godapp {
         uint8_t game_result;
         uint8_t result;
         uint8_t roundResult;
+        static constexpr uint8_t BET_TYPES = BET_PLAYER_PAIR + 1;
+        payout_table<BET_TYPES, 100> payouts;
 
         cbaccarat_result(random &random_gen) {
             draw_cards(banker_cards, banker_point, player_cards, player_point, random_gen);
@@ -38,9 +44,28 @@ namespace godapp {
 
             result = game_result | (banker_pair ? BET_BANKER_PAIR : 0) | (player_pair ? BET_PLAYER_PAIR : 0);
             roundResult = result;
+            payouts.fill<cbaccarat::bet>([&](const cbaccarat::bet &bet_item) {
+                return payout(game_result, banker_pair, player_pair, bet_item);
+            });
         }
 
         asset get_payout(const cbaccarat::bet &bet_item) {
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        // banker, player or tie, times whether each side has a pair
+        static constexpr size_t OUTCOMES = 12;
+
+        static asset outcome_payout(size_t outcome, const cbaccarat::bet &bet_item) {
+            static constexpr uint8_t GAME_RESULTS[3] = {BET_BANKER_WIN, BET_PLAYER_WIN, BET_TIE};
+            return payout(GAME_RESULTS[outcome % 3], (outcome / 3) & 1, (outcome / 6) & 1, bet_item);
+        }
+
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            return outcome_worst_payout<cbaccarat_result, cbaccarat::bet>(stakes);
+        }
+
+        static asset payout(uint8_t game_result, bool banker_pair, bool player_pair, const cbaccarat::bet &bet_item) {
             asset bet = bet_item.bet;
             switch (bet_item.bet_type) {
                 case BET_BANKER_WIN:
@@ -101,5 +126,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(cbaccarat, Baccarat Classic, cbaccarat_result, 1)
+    DEFINE_ROUND_GAME(cbaccarat)
 };
\ No newline at end of file
@@ -31,14 +31,12 @@ namespace godapp {
         init_globals(_globals, GLOBAL_ID_START, GLOBAL_ID_END);
     }
 
-    void centergame::transfer(name from, name to, asset quantity, string memo) {
-        if (!check_transfer(this, from, to, quantity, memo)) {
-            return;
-        }
+    DEFINE_ROUTED_TRANSFER(centergame)
 
-        transfer_to_house(_self, quantity, from, quantity.amount);
+    void centergame::doBet(name from, asset quantity, const string& memo, bool routed) {
+        accept_bet(_self, routed, quantity, from, quantity.amount);
         param_reader reader(memo); 
-        auto game_id = (uint64_t) atol( reader.next_param("Game ID cannot be empty!").c_str() );
+        auto game_id = reader.next_param_i64("Game ID cannot be empty!");
         auto referer = reader.get_referer(from);
         auto message = reader.rest();
 
@@ -59,7 +57,7 @@ namespace godapp {
         const std::vector<asset>& prize_amounts) {
         require_auth(_self);
 
-        payment_map pay_map;
+        payment_map pay_map(bet_ids.size());
         name empty_referer;
 
         for (int i=0; i<bet_ids.size(); i++) {
@@ -71,9 +69,9 @@ namespace godapp {
             _bets.erase(itr);
         }
 
-        for (auto& iter: pay_map.result_map) {
-            name player(iter.first);
-            const payment_map::pay_result& result = iter.second;
+        for (const auto& item: pay_map.sorted()) {
+            name player(item.player);
+            const payment_map::pay_result& result = item.result;
             delayed_action(_self, player, name("payment"), make_tuple(game_id, player,
                 result.referer, message, result.bet, result.payout), 0);
         }
@@ -34,12 +34,16 @@ namespace godapp {
         ACTION init();
         ACTION setglobal(uint64_t key, uint64_t value);
         ACTION transfer(name from, name to, asset quantity, string memo);
+        ACTION placebet(name player, asset quantity, string memo);
         ACTION reveal(uint64_t game_id, const std::string& message, const std::vector<uint64_t>& bet_ids,
             const std::vector<asset>& prize_amounts);
         ACTION payment(uint64_t id, name player, name referer, const std::string& message, asset bet, asset payout);
         ACTION clear();
 
         centergame(name receiver, name code, datastream<const char *> ds);
+
+    private:
+        void doBet(name from, asset quantity, const string& memo, bool routed);
    };
-  EOSIO_ABI_EX(centergame, (transfer)(setglobal)(reveal)(payment)(init)(clear))
+  EOSIO_ABI_EX(centergame, (transfer)(placebet)(setglobal)(reveal)(payment)(init)(clear))
 }
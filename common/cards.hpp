@@ -43,51 +43,73 @@ namespace godapp {
     }
 
     /**
-     * Get a random card from a deck, with excluded cards removed
-     * @param random_gen The random number generator
-     * @param exclude Cards excluded, expected to be sorted
-     * @param max_number Max number of cards to pull
-     * @return
+     * A deck of cards numbered [0, max_number) dealt without replacement. The dealt cards are counted in a Fenwick
+     * tree, so finding the n-th remaining card in card number order takes O(log n) and a random stream deals the same
+     * cards as bumping the drawn number past a sorted list of the cards already out.
      */
-    card_t draw_random_card(random& random_gen, vector<card_t>& exclude, card_t max_number) {
-        size_t total_dealt = exclude.size();
-        // draw a card from the remaining deck
-        auto card = (card_t) random_gen.generator(max_number - total_dealt);
-
-        // sort the excluded cards based on card number
-        sort(exclude.begin(), exclude.end());
-        // then, from the beginning of the deck, bump the card number based on the number of cards already drawn
-        for(card_t i: exclude) {
-            if (card >= i) {
-                card++;
-            } else {
-                break;
+    class card_deck {
+    public:
+        explicit card_deck(card_t max_number): _dealt_tree(max_number + 1, 0) {
+            _size = max_number;
+            _dealt = 0;
+            _top_step = 1;
+            while (_top_step * 2 <= max_number) {
+                _top_step *= 2;
             }
         }
-        return card;
-    }
 
-    /**
-     * Add a card to the target list, excluding existing cards
-     * @param random_gen Random number generator
-     * @param target Target list to add the card
-     * @param existing Cards already pulled
-     * @param max_number Max number for card that can be drawn
-     * @return the card drawn
-     */
-    card_t add_card(random& random_gen, vector<card_t>& target, vector<card_t>& existing, card_t max_number) {
-        card_t card = draw_random_card(random_gen, existing, max_number);
-        target.push_back(card);
-        existing.push_back(card);
+        card_t remaining() const {
+            return _size - _dealt;
+        }
 
-        return card;
-    }
+        /**
+         * Deal a random card from the remaining deck
+         */
+        card_t draw(random& random_gen) {
+            auto index = (card_t) random_gen.generator(remaining());
+
+            // descend the tree for the last position with no more than index cards remaining before it
+            card_t position = 0;
+            for (card_t step = _top_step; step > 0; step >>= 1) {
+                card_t next = position + step;
+                if (next <= _size) {
+                    card_t remaining_in_step = step - _dealt_tree[next];
+                    if (remaining_in_step <= index) {
+                        position = next;
+                        index -= remaining_in_step;
+                    }
+                }
+            }
 
-    void add_cards(random& random_gen, vector<card_t>& target, vector<card_t>& existing, uint8_t count, card_t max_number) {
-        for (uint8_t i=0; i<count; i++) {
-            add_card(random_gen, target, existing, max_number);
+            for (card_t i = position + 1; i <= _size; i += i & (-i)) {
+                _dealt_tree[i]++;
+            }
+            _dealt++;
+            return position;
         }
-    }
+
+        /**
+         * Deal a card and add it to the target list
+         * @return the card drawn
+         */
+        card_t add_card(random& random_gen, vector<card_t>& target) {
+            card_t card = draw(random_gen);
+            target.push_back(card);
+            return card;
+        }
+
+        void add_cards(random& random_gen, vector<card_t>& target, uint8_t count) {
+            for (uint8_t i=0; i<count; i++) {
+                add_card(random_gen, target);
+            }
+        }
+
+    private:
+        vector<card_t> _dealt_tree;     // 1-based, node i counts the dealt cards in (i - lowbit(i), i]
+        card_t _size;
+        card_t _dealt;
+        card_t _top_step;
+    };
 
     struct value_sort {
         bool operator()(const card_t& x, const card_t& y) const {return card_value(x) < card_value(y);}
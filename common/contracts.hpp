@@ -2,10 +2,12 @@
 
 #include <eosiolib/eosio.hpp>
 #include <eosiolib/transaction.hpp>
+#include <eosiolib/singleton.hpp>
 #include "./constants.hpp"
 #include "tables.hpp"
 
 #include <string>
+#include <vector>
 
 namespace godapp {
     using namespace std;
@@ -36,7 +38,7 @@ namespace godapp {
 
     template<typename T>
     void set_global(T& globals, uint64_t key, uint64_t value) {
-        table_upsert(globals, globals.get_code(), key, [&](auto& a) {
+        table_upsert_changed(globals, globals.get_code(), key, [&](auto& a) {
             a.id = key;
             a.val = value;
         });
@@ -103,6 +105,124 @@ namespace godapp {
         set_global(_globals, key, value); \
     }
 
+    //###############    Counters  ######################
+    // declared after DEFINE_GLOBAL_TABLE, the counters start from the globals rows of a contract that has no
+    // counters row yet
+    #define DEFINE_COUNTERS_TABLE \
+    TABLE counterset { \
+        uint64_t first_id; \
+        vector<uint64_t> values; \
+    }; \
+    typedef singleton<name("counters"), counterset> counters_singleton; \
+    global_counters<counterset, counters_singleton, global_index> _counters;
+
+    /**
+     * The id counters first_id..last_id of a contract, packed in one singleton row. The row is read once on first
+     * use and written once by save(), so handing out ids within an action costs no table access.
+     */
+    template<typename Row, typename Singleton, typename Globals>
+    class global_counters {
+    public:
+        global_counters(name self, Globals& globals, uint64_t first_id, uint64_t last_id):
+            _self(self), _globals(globals), _first_id(first_id), _last_id(last_id), _loaded(false), _dirty(false) {
+        }
+
+        bool contains(uint64_t key) const {
+            return key >= _first_id && key <= _last_id;
+        }
+
+        uint64_t get(uint64_t key) {
+            return value(key);
+        }
+
+        void set(uint64_t key, uint64_t new_value) {
+            value(key) = new_value;
+            _dirty = true;
+        }
+
+        /**
+         * Same as increment_global, the first id handed out is 1
+         */
+        uint64_t next(uint64_t key) {
+            return reserve(key, 1);
+        }
+
+        /**
+         * Hand out count consecutive ids at once
+         * @return the first of the ids
+         */
+        uint64_t reserve(uint64_t key, uint64_t count) {
+            uint64_t& counter = value(key);
+            uint64_t first = counter + 1;
+            counter += count;
+            _dirty = true;
+            return first;
+        }
+
+        /**
+         * Same as increment_global_mod
+         */
+        uint64_t next_mod(uint64_t key, uint64_t mod) {
+            uint64_t& counter = value(key);
+            counter = (counter + 1) % mod;
+            _dirty = true;
+            return counter;
+        }
+
+        /**
+         * Write the counters back if any of them changed
+         */
+        void save() {
+            if (_dirty) {
+                Singleton table(_self, _self.value);
+                table.set(_state, _self);
+                _dirty = false;
+            }
+        }
+
+    private:
+        Row _state;
+        name _self;
+        Globals& _globals;
+        uint64_t _first_id, _last_id;
+        bool _loaded, _dirty;
+
+        uint64_t& value(uint64_t key) {
+            eosio_assert(contains(key), "invalid counter");
+            if (!_loaded) {
+                load();
+            }
+            return _state.values[key - _first_id];
+        }
+
+        void load() {
+            Singleton table(_self, _self.value);
+            if (table.exists()) {
+                _state = table.get();
+                eosio_assert(_state.first_id == _first_id, "counters do not match this contract");
+            } else {
+                _state.first_id = _first_id;
+            }
+            // counters that are not in the row yet take over their globals value
+            for (uint64_t key = _first_id + _state.values.size(); key <= _last_id; key++) {
+                _state.values.push_back(get_global(_globals, key));
+                _dirty = true;
+            }
+            _loaded = true;
+        }
+    };
+
+    #define DEFINE_SET_COUNTER_GLOBAL(NAME) \
+    void NAME::setglobal(uint64_t key, uint64_t value) { \
+        require_auth(_self); \
+        if (_counters.contains(key)) { \
+            _counters.set(key, value); \
+            _counters.save(); \
+        } else { \
+            set_global(_globals, key, value); \
+        } \
+    }
+
     //###############    Transactions  ######################
     #define EOSIO_ABI_EX( TYPE, MEMBERS ) \
     extern "C" { \
@@ -118,6 +238,14 @@ namespace godapp {
        } \
     }
 
+    /**
+     * Assert that the transaction was started by a transfer the sender signed, so contracts cannot bet
+     */
+    void require_direct_transfer(name from) {
+        eosio::action act = eosio::get_action( 1, 0 );
+        eosio_assert(act.name == name("transfer") && act.authorization[0].actor == from, "Contract not allowed");
+    }
+
     /**
      * Check a transfer against normal issues
      * @param self A pointer for the calling contract
@@ -141,8 +269,7 @@ namespace godapp {
         eosio_assert(!memo.empty(), "Memo is required");
 
         if (block_contract) {
-            eosio::action act = eosio::get_action( 1, 0 );
-            eosio_assert(act.name == name("transfer") && act.authorization[0].actor == from, "Contract not allowed");
+            require_direct_transfer(from);
         }
 
         return true;
@@ -165,6 +292,43 @@ namespace godapp {
         deal_trx.send(player.value, self);
     }
 
+    #define PAYMENT_BATCH_SIZE 50
+
+    /**
+     * One payment row of house::paybatch
+     */
+    struct batch_payment {
+        name player;
+        asset bet;
+        asset payout;
+        name referer;
+        bool refund = false; // the payout returns the bet, so it earns no referral bonus
+    };
+
+    /**
+     * Call the house contract to pay a list of players, split into deferred transactions of PAYMENT_BATCH_SIZE
+     * rows so each one stays well within the CPU limit
+     * @param self Name of the calling contract
+     * @param batch_id Id unique to this settlement (e.g. the game id), the deferred sender ids are derived from it
+     * @param payments Payments to be made
+     * @param win_memo Memo used for players whose payout covers their bet
+     * @param lose_memo Memo used for the other players
+     * @param first_part Number of the first deferred transaction, for a settlement that pays in several calls
+     */
+    void make_batch_payment(name self, uint64_t batch_id, const vector<batch_payment>& payments,
+                            const string& win_memo, const string& lose_memo, uint64_t first_part = 0) {
+        for (size_t start = 0; start < payments.size(); start += PAYMENT_BATCH_SIZE) {
+            size_t end = std::min(payments.size(), start + PAYMENT_BATCH_SIZE);
+            vector<batch_payment> chunk(payments.begin() + start, payments.begin() + end);
+
+            transaction deal_trx;
+            deal_trx.actions.emplace_back(permission_level{self, name("active") }, HOUSE_ACCOUNT, name("paybatch"),
+                                          make_tuple(self, chunk, win_memo, lose_memo));
+            deal_trx.delay_sec = 0;
+            deal_trx.send(((uint128_t) batch_id << 64) | (first_part + start / PAYMENT_BATCH_SIZE), self);
+        }
+    }
+
     /**
      * Perform a action under a default 1 second delay
      * @param self Name of the calling contract
@@ -12,26 +12,55 @@ namespace godapp {
     using namespace std;
     using namespace eosio;
 
-#define DEFINE_BET_AMOUNT_TABLE \
-        TABLE bet_amount { \
-            name player; \
-            asset bet; \
-            uint64_t primary_key() const { return player.value; } \
-        }; \
-        typedef multi_index<name("betamount"), bet_amount> bet_amount_table; \
-        bet_amount_table _bet_amount;
-
-
-    void transfer_to_house(name self, asset quantity, name player, uint64_t max_payout) {
-        // check that the token is supported and amount is within limit, update record accordingly
+    /**
+     * @param liability worst case payout of the whole round including this bet, 0 for games without rounds
+     * @param booked whether the house already added quantity to the game balance
+     */
+    void check_bet_limit(name self, asset quantity, uint64_t max_payout, uint64_t liability = 0, bool booked = false) {
+        // check that the token is supported and amount is within limit
         house::token_index game_token(HOUSE_ACCOUNT, self.value);
         auto token_iter = game_token.find(quantity.symbol.raw());
         eosio_assert(token_iter != game_token.end(), "token is not supported");
         eosio_assert(quantity.amount >= token_iter->min && max_payout <= token_iter->max_payout, "amount not within the bet limit");
+        eosio_assert(liability <= token_iter->balance + (booked ? 0 : quantity.amount), "round liability exceeds the house balance");
+    }
+
+    void transfer_to_house(name self, asset quantity, name player, uint64_t max_payout, uint64_t liability = 0) {
+        check_bet_limit(self, quantity, max_payout, liability);
         INLINE_ACTION_SENDER(eosio::token, transfer)(EOS_TOKEN_CONTRACT, {self, name("active")},
                                                      {self, HOUSE_ACCOUNT, quantity, player.to_string()});
     }
 
+    /**
+     * Take a bet into the house. A routed bet was paid to the house directly and already booked there, only the
+     * limit is left to check.
+     */
+    void accept_bet(name self, bool routed, asset quantity, name player, uint64_t max_payout, uint64_t liability = 0) {
+        if (routed) {
+            check_bet_limit(self, quantity, max_payout, liability, true);
+        } else {
+            transfer_to_house(self, quantity, player, max_payout, liability);
+        }
+    }
+
+/**
+ * The two ways a bet reaches a game: a transfer to the game, which forwards the tokens to the house, or a transfer
+ * to the house with memo "bet,<game>,<game memo>", which the house books and hands on as placebet. Both end in
+ * NAME::doBet(player, quantity, memo, routed).
+ */
+#define DEFINE_ROUTED_TRANSFER(NAME) \
+    void NAME::transfer(name from, name to, asset quantity, string memo) { \
+        if (!check_transfer(this, from, to, quantity, memo)) { \
+            return; \
+        } \
+        doBet(from, quantity, memo, false); \
+    } \
+    \
+    void NAME::placebet(name player, asset quantity, string memo) { \
+        require_auth(HOUSE_ACCOUNT); \
+        doBet(player, quantity, memo, true); \
+    }
+
     struct seed_data {
         uint64_t game;
         uint64_t game_id;
@@ -47,11 +76,19 @@ namespace godapp {
         return seed;
     }
 
-    random random_from_sig(capi_public_key public_key, capi_checksum256 seed, capi_signature signature) {
+    /**
+     * Verify the signature over the seed and hash it into the seed of the game's random generator, which can be kept
+     * to draw the same result again later
+     */
+    capi_checksum256 random_hash_from_sig(capi_public_key public_key, capi_checksum256 seed, capi_signature signature) {
         assert_recover_key(&seed, (const char *)&signature, sizeof(signature), (const char *)&public_key, sizeof(public_key));
 
         capi_checksum256 random_num_hash;
         sha256( (char *)&signature, sizeof(signature), &random_num_hash );
-        return random(random_num_hash);
+        return random_num_hash;
+    }
+
+    random random_from_sig(capi_public_key public_key, capi_checksum256 seed, capi_signature signature) {
+        return random(random_hash_from_sig(public_key, seed, signature), RANDOM_VERSION);
     }
 }
\ No newline at end of file
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <eosiolib/eosio.hpp>
+#include <eosiolib/asset.hpp>
+#include <eosiolib/time.hpp>
+
+#define HISTORY_PAGE_SIZE           20
+
+/**
+ * History kept as a ring of pages, each row holds up to HISTORY_PAGE_SIZE entries packed as varints. Entry seq lives
+ * in page (seq / HISTORY_PAGE_SIZE) % page count, so a settlement rewrites one page, two when it crosses a page end.
+ * Entries of a page are first_seq, first_seq + 1, ... and first_seq + count - 1 of the page with the highest
+ * first_seq is the head, the sequence number of the last entry written.
+ *
+ * Entry types list their fields once for both directions:
+ *     template<typename Stream> void history_fields(Stream& s) { s.field(player).field(bet); }
+ */
+#define DEFINE_HISTORY_PAGES_TABLE \
+        TABLE histpage { \
+            uint64_t id; \
+            uint64_t first_seq; \
+            uint32_t count; \
+            vector<char> data; \
+            uint64_t primary_key() const { return id; } \
+        }; \
+        typedef multi_index<name("histpages"), histpage> history_page_table; \
+        typedef history_writer<history_page_table, histpage> history_log;
+
+namespace godapp {
+    using namespace std;
+    using namespace eosio;
+
+    /**
+     * Appends fields as LEB128 varints, signed values zigzag encoded. A checksum is copied as its 32 raw bytes.
+     */
+    class history_encoder {
+    public:
+        history_encoder(vector<char>& out): _out(out) {
+        }
+
+        history_encoder& field(uint64_t value) {
+            while (value >= 0x80) {
+                _out.push_back((char) (value | 0x80));
+                value >>= 7;
+            }
+            _out.push_back((char) value);
+            return *this;
+        }
+
+        history_encoder& field(int64_t value) {
+            return field(((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+        }
+
+        history_encoder& field(uint32_t value) { return field((uint64_t) value); }
+        history_encoder& field(uint16_t value) { return field((uint64_t) value); }
+        history_encoder& field(uint8_t value) { return field((uint64_t) value); }
+        history_encoder& field(bool value) { return field((uint64_t) value); }
+        history_encoder& field(name value) { return field(value.value); }
+        history_encoder& field(symbol value) { return field(value.raw()); }
+        history_encoder& field(time_point_sec value) { return field(value.utc_seconds); }
+
+        history_encoder& field(const asset& value) {
+            return field(value.amount).field(value.symbol);
+        }
+
+        history_encoder& field(const capi_checksum256& value) {
+            _out.insert(_out.end(), (const char*) value.hash, (const char*) value.hash + sizeof(value.hash));
+            return *this;
+        }
+
+        history_encoder& field(const vector<uint8_t>& value) {
+            field((uint64_t) value.size());
+            _out.insert(_out.end(), value.begin(), value.end());
+            return *this;
+        }
+
+    private:
+        vector<char>& _out;
+    };
+
+    /**
+     * Reads back what history_encoder wrote, asserts when a page is truncated
+     */
+    class history_decoder {
+    public:
+        history_decoder(const vector<char>& in): _in(in), _pos(0) {
+        }
+
+        history_decoder& field(uint64_t& value) {
+            value = 0;
+            for (uint8_t shift = 0; ; shift += 7) {
+                eosio_assert(_pos < _in.size() && shift < 64, "history page is corrupted");
+                uint8_t byte = (uint8_t) _in[_pos++];
+                value |= (uint64_t) (byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0) {
+                    return *this;
+                }
+            }
+        }
+
+        history_decoder& field(int64_t& value) {
+            uint64_t encoded;
+            field(encoded);
+            value = (int64_t) (encoded >> 1) ^ -(int64_t) (encoded & 1);
+            return *this;
+        }
+
+        template<typename T>
+        history_decoder& narrow(T& value) {
+            uint64_t wide;
+            field(wide);
+            value = (T) wide;
+            return *this;
+        }
+
+        history_decoder& field(uint32_t& value) { return narrow(value); }
+        history_decoder& field(uint16_t& value) { return narrow(value); }
+        history_decoder& field(uint8_t& value) { return narrow(value); }
+        history_decoder& field(bool& value) { return narrow(value); }
+
+        history_decoder& field(name& value) {
+            return field(value.value);
+        }
+
+        history_decoder& field(symbol& value) {
+            uint64_t raw;
+            field(raw);
+            value = symbol(raw);
+            return *this;
+        }
+
+        history_decoder& field(time_point_sec& value) {
+            return field(value.utc_seconds);
+        }
+
+        history_decoder& field(asset& value) {
+            return field(value.amount).field(value.symbol);
+        }
+
+        history_decoder& field(capi_checksum256& value) {
+            eosio_assert(_pos + sizeof(value.hash) <= _in.size(), "history page is corrupted");
+            memcpy(value.hash, _in.data() + _pos, sizeof(value.hash));
+            _pos += sizeof(value.hash);
+            return *this;
+        }
+
+        history_decoder& field(vector<uint8_t>& value) {
+            uint64_t size;
+            field(size);
+            eosio_assert(size <= _in.size() - _pos, "history page is corrupted");
+            value.assign(_in.begin() + _pos, _in.begin() + _pos + size);
+            _pos += size;
+            return *this;
+        }
+
+    private:
+        const vector<char>& _in;
+        size_t _pos;
+    };
+
+    /**
+     * Buffers the page being appended to and writes it once, on flush() or when the next entry moves on to another
+     * page. The caller keeps the head in its own counter and stores last_seq() back after flushing.
+     */
+    template<typename Table, typename Page>
+    class history_writer {
+    public:
+        /**
+         * @param last_seq sequence number of the last entry written, the first entry appended gets last_seq + 1
+         * @param keep number of latest entries that stay readable
+         */
+        history_writer(name self, uint64_t last_seq, uint64_t keep):
+            _table(self, self.value), _self(self), _last_seq(last_seq), _pages(keep / HISTORY_PAGE_SIZE + 1),
+            _loaded(false), _dirty(false) {
+        }
+
+        /**
+         * @return sequence number of the entry
+         */
+        template<typename Entry>
+        uint64_t append(Entry entry) {
+            uint64_t seq = ++_last_seq;
+            if (!_loaded || seq % HISTORY_PAGE_SIZE == 0) {
+                flush();
+                load((seq / HISTORY_PAGE_SIZE) % _pages, seq);
+            }
+
+            history_encoder encoder(_page.data);
+            entry.history_fields(encoder);
+            _page.count++;
+            _dirty = true;
+            return seq;
+        }
+
+        uint64_t last_seq() const {
+            return _last_seq;
+        }
+
+        void flush() {
+            if (!_dirty) {
+                return;
+            }
+            auto iter = _table.find(_page.id);
+            if (iter == _table.end()) {
+                _table.emplace(_self, [&](auto& a) {
+                    a = _page;
+                });
+            } else {
+                _table.modify(iter, _self, [&](auto& a) {
+                    a = _page;
+                });
+            }
+            _dirty = false;
+        }
+
+    private:
+        Table _table;
+        name _self;
+        uint64_t _last_seq;
+        uint64_t _pages;
+        Page _page;
+        bool _loaded, _dirty;
+
+        // a page is continued only if seq follows its last entry, one left from an older lap of the ring or from
+        // before the head was reset starts over
+        void load(uint64_t page_id, uint64_t seq) {
+            auto iter = _table.find(page_id);
+            if (iter != _table.end() && iter->first_seq / HISTORY_PAGE_SIZE == seq / HISTORY_PAGE_SIZE
+                    && iter->first_seq + iter->count == seq) {
+                _page = *iter;
+            } else {
+                _page.id = page_id;
+                _page.first_seq = seq;
+                _page.count = 0;
+                _page.data.clear();
+                _page.data.reserve(HISTORY_PAGE_SIZE * 32);
+            }
+            _loaded = true;
+        }
+    };
+
+    /**
+     * Decode the entries of one page, callback(seq, entry) is called oldest first
+     */
+    template<typename Entry, typename Page, typename Callback>
+    void read_history_page(const Page& page, Callback&& callback) {
+        history_decoder decoder(page.data);
+        for (uint32_t i = 0; i < page.count; i++) {
+            Entry entry;
+            entry.history_fields(decoder);
+            callback(page.first_seq + i, entry);
+        }
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <eosiolib/eosio.hpp>
 #include "./constants.hpp"
 
@@ -8,30 +9,43 @@ namespace godapp {
     using namespace std;
     using namespace eosio;
 
+    /**
+     * Splits a transfer memo into separated fields. Fields are views into the memo and numbers are parsed in place,
+     * so reading a memo does not allocate.
+     */
     class param_reader {
     public:
-        param_reader(const string& params, char separator = ','):_params(params), _last_pos(0) {
+        param_reader(const string& params, char separator = ','):_params(params), _separator(separator), _last_pos(0) {
         }
 
-        string next_param(const char* error_msg = "param missing") {
-            size_t new_pos = _params.find(',', _last_pos);
-            eosio_assert(new_pos >= 0, error_msg);
+        /**
+         * Next field, empty if the memo is used up. The view is only valid while the memo is alive, error_msg is
+         * raised by the number readers when the field is empty.
+         */
+        string_view next_param(const char* error_msg = "param missing") {
+            if (_last_pos >= _params.length()) {
+                return string_view();
+            }
 
-            string result = _params.substr(_last_pos, new_pos - _last_pos);
+            size_t new_pos = _params.find(_separator, _last_pos);
+            if (new_pos == string_view::npos) {
+                new_pos = _params.length();
+            }
+            string_view result = _params.substr(_last_pos, new_pos - _last_pos);
             _last_pos = new_pos + 1;
             return result;
         }
 
         uint8_t next_param_i(const char* error_msg = "param missing") {
-            return (uint8_t) atoi(next_param(error_msg).c_str());
+            return (uint8_t) parse_number(next_param(error_msg), UINT8_MAX, error_msg);
         }
 
         uint64_t next_param_i64(const char* error_msg = "param missing") {
-            return (uint64_t) atoi(next_param(error_msg).c_str());
+            return parse_number(next_param(error_msg), UINT64_MAX, error_msg);
         }
 
         string rest() {
-            return _params.substr(_last_pos, _params.length() - _last_pos);
+            return has_next() ? string(_params.substr(_last_pos)) : string();
         }
 
         bool has_next() {
@@ -39,7 +53,7 @@ namespace godapp {
         }
 
         name get_referer(name from, name default_referer = HOUSE_ACCOUNT) {
-            string referer_name = next_param("referrer is missing");
+            string_view referer_name = next_param("referrer is missing");
             if (referer_name.empty()) {
                 return default_referer;
             } else {
@@ -53,7 +67,24 @@ namespace godapp {
         }
 
     private:
-        const string& _params;
+        string_view _params;
+        char _separator;
         size_t _last_pos;
+
+        /**
+         * Parse an unsigned decimal field, rejecting empty fields, other characters and values above max
+         */
+        static uint64_t parse_number(string_view param, uint64_t max, const char* error_msg) {
+            eosio_assert(!param.empty(), error_msg);
+
+            uint64_t value = 0;
+            for (char c: param) {
+                eosio_assert(c >= '0' && c <= '9', "param is not a number");
+                uint64_t digit = (uint64_t) (c - '0');
+                eosio_assert(value <= (max - digit) / 10, "param is out of range");
+                value = value * 10 + digit;
+            }
+            return value;
+        }
     };
-}
\ No newline at end of file
+}
@@ -3,13 +3,21 @@
 #include <eosiolib/eosio.hpp>
 #include <eosiolib/asset.hpp>
 
-#include <map>
+#include <algorithm>
+#include <vector>
 #include "constants.hpp"
 
+#define PAYMENT_MAP_MIN_CAPACITY    16
+
 namespace godapp {
     using namespace eosio;
     using namespace std;
 
+    /**
+     * Accumulates bets and payouts per player. Results are kept in one flat vector with an open addressing index
+     * over it, so adding a payment does not allocate once the map has been reserved for the expected number of
+     * players.
+     */
     class payment_map {
     public:
         struct pay_result {
@@ -18,27 +26,94 @@ namespace godapp {
             name referer;
         };
 
-        std::map<uint64_t, pay_result> result_map;
+        struct entry {
+            uint64_t player;
+            pay_result result;
+        };
+
         uint64_t largest_winner = 0;
         int64_t win_amount = 0;
 
+        /**
+         * @param expected Expected number of players, e.g. the number of bets being settled
+         */
+        explicit payment_map(size_t expected = 0) {
+            reserve(expected);
+        }
+
+        /**
+         * Make room for the given number of players without further allocation
+         */
+        void reserve(size_t expected) {
+            _entries.reserve(expected);
+            size_t capacity = PAYMENT_MAP_MIN_CAPACITY;
+            while (capacity < expected * 2) {
+                capacity <<= 1;
+            }
+            if (capacity > _slots.size()) {
+                rehash(capacity);
+            }
+        }
+
         void add_payment(name player, asset bet, asset payout, name referer) {
-            auto result_itr = result_map.find(player.value);
-            if (result_itr == result_map.end()) {
-                result_map[player.value] = pay_result{bet, payout, referer};
-            } else {
-                result_itr->second.bet += bet;
-                result_itr->second.payout += payout;
+            uint32_t& slot = find_slot(player.value);
+            if (slot != 0) {
+                pay_result& result = _entries[slot - 1].result;
+                result.bet += bet;
+                result.payout += payout;
+                return;
+            }
+
+            _entries.push_back(entry{player.value, pay_result{bet, payout, referer}});
+            slot = (uint32_t) _entries.size();
+            if (_entries.size() * 2 > _slots.size()) {
+                rehash(_slots.size() * 2);
             }
         }
 
-        void track_largest_winner(std::map<uint64_t, pay_result>::iterator itr) {
-            pay_result& current = itr->second;
+        size_t size() const {
+            return _entries.size();
+        }
+
+        /**
+         * Results ordered by player, the same order a std::map keyed by name.value would give
+         */
+        const vector<entry>& sorted() {
+            sort(_entries.begin(), _entries.end(), [](const entry& a, const entry& b) {
+                return a.player < b.player;
+            });
+            rehash(_slots.size());
+            return _entries;
+        }
+
+        void track_largest_winner(const entry& item) {
+            const pay_result& current = item.result;
             if (current.payout.amount > current.bet.amount && current.payout.amount > win_amount &&
                 current.payout.symbol == EOS_SYMBOL) {
-                largest_winner = itr->first;
+                largest_winner = item.player;
                 win_amount = current.payout.amount;
             }
         }
+
+    private:
+        vector<entry> _entries;
+        vector<uint32_t> _slots;    // 1-based index into _entries, 0 when empty
+
+        uint32_t& find_slot(uint64_t player) {
+            size_t mask = _slots.size() - 1;
+            // fibonacci hashing, name values share most of their low bits
+            size_t pos = (size_t) ((player * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+            while (_slots[pos] != 0 && _entries[_slots[pos] - 1].player != player) {
+                pos = (pos + 1) & mask;
+            }
+            return _slots[pos];
+        }
+
+        void rehash(size_t capacity) {
+            _slots.assign(capacity, 0);
+            for (size_t i = 0; i < _entries.size(); i++) {
+                find_slot(_entries[i].player) = (uint32_t) (i + 1);
+            }
+        }
     };
-}
\ No newline at end of file
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <eosiolib/eosio.hpp>
+#include <eosiolib/asset.hpp>
+#include "constants.hpp"
+
+namespace godapp {
+    using namespace std;
+    using namespace eosio;
+
+    /**
+     * Payout rates of a drawn round by bet type. Bet types below BET_TYPES have a rate each and all other types share
+     * the rate of BET_TYPES. A bet pays bet * rate / DENOMINATOR, so settling it is one lookup and one multiply.
+     */
+    template<uint8_t BET_TYPES, int64_t DENOMINATOR>
+    class payout_table {
+    public:
+        /**
+         * Take each rate from the game's payout rule, applied once per bet type to a bet of DENOMINATOR units
+         */
+        template<typename Bet, typename Rule>
+        void fill(Rule&& rule) {
+            for (uint8_t bet_type = 0; bet_type <= BET_TYPES; bet_type++) {
+                _rates[bet_type] = rule(Bet{asset(DENOMINATOR, EOS_SYMBOL), bet_type}).amount;
+            }
+        }
+
+        /**
+         * Every bet type pays back its bet, for a round closed without a draw
+         */
+        void refund() {
+            fill_n(_rates, BET_TYPES + 1, DENOMINATOR);
+        }
+
+        /**
+         * The rates as stored with a round still being settled, load() takes them back
+         */
+        vector<int64_t> rates() const {
+            return vector<int64_t>(_rates, _rates + BET_TYPES + 1);
+        }
+
+        void load(const vector<int64_t>& rates) {
+            eosio_assert(rates.size() == BET_TYPES + 1, "payout rates do not match the game");
+            copy(rates.begin(), rates.end(), _rates);
+        }
+
+        asset payout(const asset& bet, uint8_t bet_type) const {
+            return bet * _rates[bet_type < BET_TYPES ? bet_type : BET_TYPES] / DENOMINATOR;
+        }
+
+    private:
+        int64_t _rates[BET_TYPES + 1];
+    };
+}
@@ -3,6 +3,20 @@
 #include <eosiolib/crypto.h>
 #include <eosiolib/transaction.hpp>
 
+// Version 1 hashes the seed chain once per draw and takes the draw modulo max. Version 2 splits every digest of the
+// same chain into eight 32-bit lanes and draws from them with rejection sampling, so there is no modulo bias and
+// most draws cost no hash at all. A contract opts in by defining RANDOM_VERSION before its includes; rounds keep
+// replaying only with the version they were revealed with.
+#define RANDOM_VERSION_1            1
+#define RANDOM_VERSION_2            2
+
+#ifndef RANDOM_VERSION
+#define RANDOM_VERSION              RANDOM_VERSION_1
+#endif
+
+#define RANDOM_LANES                8
+#define RANDOM_LANE_RANGE           (1ull << 32)
+
 /**
  * Random number generator picked from EOS.WIN
  */
@@ -29,7 +43,7 @@ namespace godapp {
 
     public:
         random(uint64_t mixed = 0);
-        random(capi_checksum256 seed);
+        random(capi_checksum256 seed, uint8_t version = RANDOM_VERSION_1);
         ~random();
 
         void seed(capi_checksum256 sseed, capi_checksum256 useed);
@@ -43,11 +57,18 @@ namespace godapp {
     private:
         capi_checksum256 _mixed;
         capi_checksum256 _seed;
+        uint8_t _version;
+        uint8_t _next_lane;
+
+        uint32_t next_lane();
+        uint64_t next_word();
     };
 
-    random::random(capi_checksum256 seed) {
+    random::random(capi_checksum256 seed, uint8_t version) {
         _seed = seed;
         _mixed = seed;
+        _version = version;
+        _next_lane = RANDOM_LANES;
     }
 
     random::~random() {}
@@ -66,11 +87,45 @@ namespace godapp {
     }
 
     uint64_t random::generator(uint64_t max) {
-        mixseed(_mixed, _seed, _seed);
+        if (_version == RANDOM_VERSION_1) {
+            mixseed(_mixed, _seed, _seed);
+
+            uint64_t r = gen(_seed, max);
+
+            return r;
+        }
+
+        if (max == 0) {
+            return next_word();
+        }
+        uint64_t value;
+        if (max <= RANDOM_LANE_RANGE) {
+            // reject the top RANDOM_LANE_RANGE % max lane values, which would favor the low results
+            uint64_t limit = RANDOM_LANE_RANGE - RANDOM_LANE_RANGE % max;
+            do {
+                value = next_lane();
+            } while (value >= limit);
+        } else {
+            uint64_t rejected = (UINT64_MAX % max + 1) % max;
+            do {
+                value = next_word();
+            } while (value > UINT64_MAX - rejected);
+        }
+        return value % max;
+    }
 
-        uint64_t r = gen(_seed, max);
+    uint32_t random::next_lane() {
+        if (_next_lane == RANDOM_LANES) {
+            mixseed(_mixed, _seed, _seed);
+            _next_lane = 0;
+        }
+        const uint32_t *p32 = reinterpret_cast<const uint32_t *>(&_seed);
+        return p32[_next_lane++];
+    }
 
-        return r;
+    uint64_t random::next_word() {
+        uint64_t high = next_lane();
+        return (high << 32) | next_lane();
     }
 
     uint64_t random::gen(capi_checksum256 &seed, uint64_t max) const {
@@ -1,18 +1,38 @@
+#pragma once
+
 #include <eosiolib/eosio.hpp>
 #include <eosiolib/print.hpp>
+#include <algorithm>
 #include "contracts.hpp"
 #include "game_contracts.hpp"
+#include "tables.hpp"
+#include "param_reader.hpp"
+#include "payment_map.hpp"
+#include "payout_table.hpp"
+#include "history.hpp"
+
+// counters shared by all round games
+#define G_ID_START                  101
+#define G_ID_RESULT_ID              101
+#define G_ID_GAME_ID                102
+#define G_ID_BET_ID                 103
+#define G_ID_HISTORY_ID             104
+#define G_ID_END                    104
 
 #define GAME_STATUS_STANDBY         1
 #define GAME_STATUS_ACTIVE          2
 #define GAME_REVEAL_PRESET          5
+#define RESULT_MAP_RESERVE          64
+#define SETTLE_CHUNK_SIZE           100
+#define SETTLE_RETRY_TIME           60
+#define REFUND_MEMO                 "[Dapp365] Round closed, bet refunded"
 
 #define DEFINE_GAMES_TABLE(GAME_DATA)  \
         TABLE game { \
             uint64_t id; \
             uint64_t end_time; \
             GAME_DATA \
-            symbol symbol; \
+            eosio::symbol symbol; \
             uint8_t status; \
             name largest_winner; \
             asset largest_win_amount; \
@@ -23,44 +43,87 @@
         typedef multi_index<name("activegame"), game, \
             indexed_by< name("byid"), const_mem_fun<game, uint64_t, &game::byid> > \
         > games_table; \
-        games_table _games; \
-        \
-        struct pay_result { \
-            asset bet; \
-            asset payout; \
-            name referer; \
-        };
+        games_table _games;
 
 
 #define DEFINE_BETS_TABLE \
-        TABLE bet { \
+        struct bet { \
+            asset bet; \
+            uint8_t bet_type; \
+        }; \
+        struct bet_entry { \
+            uint8_t bet_type; \
+            int64_t amount; \
+        }; \
+        TABLE player_bet { \
             uint64_t id; \
             uint64_t game_id; \
             name player; \
             name referer; \
-            asset bet; \
-            uint8_t bet_type; \
+            asset total; \
+            vector<bet_entry> bets; \
             uint64_t primary_key() const { return id; } \
             uint64_t bygameid() const {return game_id;} \
+            uint64_t byplayer() const {return player.value;} \
         }; \
-        typedef multi_index<name("bets"), bet, \
-                indexed_by< name("bygameid"), const_mem_fun<bet, uint64_t, &bet::bygameid> > \
+        typedef multi_index<name("playerbets"), player_bet, \
+                indexed_by< name("bygameid"), const_mem_fun<player_bet, uint64_t, &player_bet::bygameid> >, \
+                indexed_by< name("byplayer"), const_mem_fun<player_bet, uint64_t, &player_bet::byplayer> > \
         > bet_table; \
         bet_table _bets;
 
+/**
+ * Stakes of the active round by bet type, one entry per type bet on, so a bet adds to one entry instead of the round's
+ * bets being rescanned. The game's Result turns them into the round's worst case payout with worst_payout(stakes).
+ */
+#define DEFINE_ROUND_RISK_TABLE \
+        TABLE round_risk { \
+            eosio::symbol symbol; \
+            uint64_t game_id = 0; \
+            vector<bet_entry> stakes; \
+            uint64_t primary_key() const { return symbol.raw(); } \
+        }; \
+        typedef multi_index<name("roundrisk"), round_risk> round_risk_table; \
+        round_risk_table _risks;
+
+/**
+ * Progress of a revealed round whose bets are still being paid, one row per round so it can overlap the next round of
+ * the symbol. The draw is kept as its result and payout rates, so every chunk pays what was revealed even if the
+ * contract was updated to another random version meanwhile. A hard closed round is settled the same way with every
+ * rate refunding the bet. Settled bets are erased so the next chunk starts at the first bet left. owed is what the
+ * round has left to pay, it counts towards the liability of the next rounds of the symbol until the row is erased.
+ */
+#define DEFINE_SETTLEMENT_TABLE \
+        TABLE settlement { \
+            uint64_t game_id = 0; \
+            eosio::symbol symbol; \
+            uint64_t result = 0; \
+            vector<int64_t> rates; \
+            uint32_t close_time = 0; \
+            uint64_t settled = 0; \
+            name largest_winner; \
+            int64_t win_amount = 0; \
+            bool refund = false; \
+            int64_t owed = 0; \
+            uint32_t update_time = 0; \
+            uint64_t primary_key() const { return game_id; } \
+        }; \
+        typedef multi_index<name("settlements"), settlement> settlement_table; \
+        settlement_table _settlements;
+
 #define DEFINE_HISTORY_TABLE \
-        TABLE history { \
-            uint64_t id; \
-            uint64_t history_id; \
+        struct history { \
             name player; \
             asset bet; \
             uint8_t bet_type; \
             asset payout; \
             uint64_t close_time; \
             uint64_t result; \
-            uint64_t primary_key() const { return id; } \
+            template<typename Stream> void history_fields(Stream& s) { \
+                s.field(player).field(bet).field(bet_type).field(payout).field(close_time).field(result); \
+            } \
         }; \
-        typedef multi_index<name("histories"), history> history_table; \
+        DEFINE_HISTORY_PAGES_TABLE
 
 #define DEFINE_RESULTS_TABLE \
         TABLE result { \
@@ -81,217 +144,467 @@ public: \
         ACTION newround(symbol symbol_type); \
         ACTION hardclose(uint64_t game_id); \
         ACTION transfer(name from, name to, asset quantity, string memo); \
+        ACTION placebet(name player, asset quantity, string memo); \
+        ACTION settle(uint64_t game_id); \
 private: \
-        void initsymbol(symbol sym); \
-        void doReveal(uint64_t game_id, random& random);
+        void doBet(name from, asset quantity, const string& memo, bool routed);
+
+#define STANDARD_ACTIONS (init)(reveal)(transfer)(placebet)(settle)(newround)(setglobal)(hardclose)
+
+namespace godapp {
+    using namespace std;
+    using namespace eosio;
+
+    /**
+     * Row of the histories ring the round games kept before history moved to pages, only read to erase what is left
+     */
+    struct legacy_history {
+        uint64_t id;
+        uint64_t primary_key() const { return id; }
+    };
+    typedef multi_index<name("histories"), legacy_history> legacy_history_table;
+
+    /**
+     * Worst case payout of a round from its stakes by bet type, for a Result with few outcomes: OUTCOMES and
+     * outcome_payout(outcome, bet), where an outcome may stand for several draws as long as its payouts are the
+     * highest of them. stakes[Result::BET_TYPES] holds the bet types past the payout table.
+     */
+    template<typename Result, typename Bet>
+    int64_t outcome_worst_payout(const vector<int64_t>& stakes) {
+        int64_t worst = 0;
+        for (size_t outcome = 0; outcome < Result::OUTCOMES; outcome++) {
+            int64_t total = 0;
+            for (uint8_t bet_type = 0; bet_type < stakes.size(); bet_type++) {
+                if (stakes[bet_type] > 0) {
+                    total += Result::outcome_payout(outcome, Bet{asset(stakes[bet_type], EOS_SYMBOL), bet_type}).amount;
+                }
+            }
+            worst = max(worst, total);
+        }
+        return worst;
+    }
+
+    /**
+     * Rules shared by the round games. Derived is the contract, it declares the tables and the actions because the
+     * ABI is generated from the contract class, and DEFINE_ROUND_GAME forwards its actions here. Result draws a round
+     * from a random generator and pays its bets, Config holds the game's constants:
+     *     struct Config {
+     *         static constexpr uint32_t GAME_LENGTH = 45;          // seconds a round takes bets
+     *         static constexpr uint64_t RESULT_SIZE = 100;         // rows of the results ring
+     *         static constexpr uint64_t HISTORY_SIZE = 100;        // history entries kept readable
+     *         static constexpr int64_t REFERRAL_FACTOR = 1;        // bets are divided by it for the referral bonus
+     *         static constexpr const char* WIN_MEMO = "[Dapp365] Roulette win!";
+     *         static constexpr const char* LOSE_MEMO = "[Dapp365] Roulette lose!";
+     *     };
+     */
+    template<typename Derived, typename Result, typename Config>
+    class round_game: public contract {
+    public:
+        using contract::contract;
+
+    protected:
+        void init_game() {
+            require_auth(HOUSE_ACCOUNT);
+            init_symbol(EOS_SYMBOL);
+
+            // the old ring holds at most HISTORY_SIZE rows, the page history continues from the same head
+            legacy_history_table legacy(_self, _self.value);
+            for (auto iter = legacy.begin(); iter != legacy.end();) {
+                iter = legacy.erase(iter);
+            }
+        }
+
+        void new_round(symbol symbol_type) {
+            require_auth(_self);
+            auto& games = derived()._games;
+            uint32_t timestamp = now();
+            auto game_iter = games.find(symbol_type.raw());
+            eosio_assert(game_iter->status == GAME_STATUS_STANDBY, "Round already started");
+            eosio_assert(timestamp >= game_iter->end_time, "Game resolving, please wait");
+            games.modify(game_iter, _self, [&](auto &a) {
+                a.end_time = timestamp + Config::GAME_LENGTH;
+                a.seed = create_seed(_self.value, a.id);
+                a.status = GAME_STATUS_ACTIVE;
+            });
+        }
+
+        /**
+         * Close a round that cannot be revealed and move the symbol on to the next game id. The bets of the closed
+         * round are refunded, in chunks like the settlement of a reveal.
+         */
+        void hard_close(uint64_t game_id) {
+            require_auth(_self);
+            auto& counters = derived()._counters;
+            auto idx = derived()._games.template get_index<name("byid")>();
+            auto gm_pos = idx.find(game_id);
+            uint32_t timestamp = now();
+            eosio_assert(gm_pos != idx.end() && gm_pos->id == game_id, "hardclose: game id does't exist!");
+            symbol game_symbol = gm_pos->symbol;
+            uint64_t next_game_id = counters.next(G_ID_GAME_ID);
+            idx.modify(gm_pos, _self, [&](auto &a) {
+                a.id = next_game_id;
+                a.status = GAME_STATUS_STANDBY;
+                a.end_time = timestamp;
+            });
+            counters.save();
+
+            auto bet_index = derived()._bets.template get_index<name("bygameid")>();
+            auto bet_iter = bet_index.lower_bound(game_id);
+            if (bet_iter == bet_index.end() || bet_iter->game_id != game_id) {
+                return;
+            }
+            decltype(Result::payouts) refunds;
+            refunds.refund();
+            derived()._settlements.emplace(_self, [&](auto &a) {
+                a.game_id = game_id;
+                a.symbol = game_symbol;
+                a.rates = refunds.rates();
+                a.close_time = timestamp;
+                a.refund = true;
+                a.owed = round_payout(game_id, game_symbol, refunds);
+                a.update_time = timestamp;
+            });
+            settle_chunk(game_id);
+        }
+
+        void place_bet(name from, asset quantity, const string& memo, bool routed) {
+            auto& counters = derived()._counters;
+            auto& bets = derived()._bets;
+            auto& risks = derived()._risks;
+            param_reader reader(memo);
+            auto game_id = reader.next_param_i64("Game ID cannot be empty!");
+            auto referer = reader.get_referer(from);
+            auto game_iter = derived()._games.find(quantity.symbol.raw());
+            eosio_assert(game_iter->id == game_id, "Game is no longer active");
+            uint32_t timestamp = now();
+            uint8_t status = game_iter->status;
+            switch (status) {
+                case GAME_STATUS_STANDBY: {
+                    SEND_INLINE_ACTION(derived(), newround, {_self, name("active")}, {quantity.symbol});
+                    break;
+                }
+                case GAME_STATUS_ACTIVE:
+                    eosio_assert((timestamp + GAME_REVEAL_PRESET) < game_iter->end_time, "Game already finished, please wait for next round");
+                    break;
+                default:
+                    eosio_assert(false, "Invalid game state");
+            }
+            auto player_index = bets.template get_index<name("byplayer")>();
+            auto bet_iter = player_index.find(from.value);
+            while (bet_iter != player_index.end() && bet_iter->player == from && bet_iter->game_id != game_id) {
+                bet_iter++;
+            }
+            bool existing = bet_iter != player_index.end() && bet_iter->player == from;
+            typename Derived::player_bet row;
+            if (existing) {
+                row = *bet_iter;
+            } else {
+                row.id = counters.next(G_ID_BET_ID);
+                row.game_id = game_id;
+                row.player = from;
+                row.referer = referer;
+                row.total = asset(0, quantity.symbol);
+            }
+            auto risk_iter = risks.find(quantity.symbol.raw());
+            typename Derived::round_risk risk;
+            if (risk_iter != risks.end() && risk_iter->game_id == game_id) {
+                risk = *risk_iter;
+            } else {
+                risk.symbol = quantity.symbol;
+                risk.game_id = game_id;
+            }
+            asset total = asset(0, quantity.symbol);
+            while(reader.has_next()) {
+                uint8_t bet_type = reader.next_param_i("Bet type cannot be empty!");
+                uint64_t amount = reader.next_param_i64("Bet amount cannot be empty!");
+                asset bet_amount(amount, quantity.symbol);
+                eosio_assert(bet_amount.amount > 0, "Bet amount must be positive");
+                total += bet_amount;
+                add_stake(row.bets, bet_type, bet_amount.amount);
+                add_stake(risk.stakes, bet_type, bet_amount.amount);
+            }
+            eosio_assert(quantity == total, "bet amount does not match transfer amount");
+            row.total += total;
+            int64_t liability = Result::worst_payout(stakes_by_type(risk.stakes)) + unsettled_payout(quantity.symbol);
+            accept_bet(_self, routed, quantity, from, row.total.amount, liability);
+            if (risk_iter == risks.end()) {
+                risks.emplace(_self, [&](auto &a) {
+                    a = risk;
+                });
+            } else {
+                risks.modify(risk_iter, _self, [&](auto &a) {
+                    a = risk;
+                });
+            }
+            if (existing) {
+                player_index.modify(bet_iter, _self, [&](auto &a) {
+                    a = row;
+                });
+            } else {
+                bets.emplace(_self, [&](auto &a) {
+                    a = row;
+                });
+            }
+            counters.save();
+        }
+
+        /**
+         * Draw the result, record it and move the symbol on to the next game id right away, so bets on it are taken
+         * while this round is paid. The first SETTLE_CHUNK_SIZE bet rows are settled here, each further
+         * chunk runs as a deferred settle action.
+         */
+        void reveal_round(uint64_t game_id, capi_signature signature) {
+            auto& counters = derived()._counters;
+            auto idx = derived()._games.template get_index<name("byid")>();
+            auto gm_pos = idx.find(game_id);
+            uint32_t timestamp = now();
+
+            eosio_assert(gm_pos != idx.end() && gm_pos->id == game_id, "reveal: game id does't exist!");
+            eosio_assert(gm_pos->status == GAME_STATUS_ACTIVE && (timestamp + GAME_REVEAL_PRESET) >= gm_pos->end_time, "Can not reveal yet");
+            typename Derived::randkeys_index random_keys(HOUSE_ACCOUNT, HOUSE_ACCOUNT.value);
+            capi_public_key random_key = random_keys.get(0, "random key is not set").key;
+            capi_checksum256 random_hash = random_hash_from_sig(random_key, gm_pos->seed, signature);
+            random random_gen(random_hash, RANDOM_VERSION);
+            Result result(random_gen);
+            capi_checksum256 game_seed = gm_pos->seed;
+            symbol game_symbol = gm_pos->symbol;
+            unsettled_payout(game_symbol);
+            uint64_t next_game_id = counters.next(G_ID_GAME_ID);
+            // the next round waits in standby for its first bet, which opens it through newround with no resolve gap
+            idx.modify(gm_pos, _self, [&](auto &a) {
+                a.id = next_game_id;
+                a.status = GAME_STATUS_STANDBY;
+                a.end_time = timestamp;
+                result.update_game(a);
+            });
+            uint64_t result_index = counters.next_mod(G_ID_RESULT_ID, Config::RESULT_SIZE);
+            table_upsert(derived()._results, _self, result_index, [&](auto &a) {
+                a.id = result_index;
+                a.game_id = game_id;
+                a.result = result.roundResult;
+            });
+            derived()._settlements.emplace(_self, [&](auto &a) {
+                a.game_id = game_id;
+                a.symbol = game_symbol;
+                a.result = result.result;
+                a.rates = result.payouts.rates();
+                a.close_time = timestamp;
+                a.owed = round_payout(game_id, game_symbol, result.payouts);
+                a.update_time = timestamp;
+            });
+            result.set_receipt(derived(), game_id, game_seed);
+            settle_chunk(game_id);
+        }
 
-#define STANDARD_ACTIONS (init)(reveal)(transfer)(newround)(setglobal)(hardclose)
+        void settle_round(uint64_t game_id) {
+            require_auth(_self);
+            settle_chunk(game_id);
+        }
 
-#define DEFINE_CONSTRUCTOR(NAME) \
+    private:
+        Derived& derived() {
+            return static_cast<Derived&>(*this);
+        }
+
+        /**
+         * What the rounds of the symbol still being settled have left to pay. The settle chain of a round that has not
+         * moved for SETTLE_RETRY_TIME seconds, because its deferred settle failed or expired, is started again.
+         */
+        int64_t unsettled_payout(symbol sym) {
+            auto& settlements = derived()._settlements;
+            uint32_t timestamp = now();
+            int64_t owed = 0;
+            for (auto iter = settlements.begin(); iter != settlements.end(); iter++) {
+                if (iter->symbol != sym) {
+                    continue;
+                }
+                owed += iter->owed;
+                if (timestamp >= iter->update_time + SETTLE_RETRY_TIME) {
+                    uint64_t game_id = iter->game_id;
+                    settlements.modify(iter, _self, [&](auto &a) {
+                        a.update_time = timestamp;
+                    });
+                    cancel_deferred(game_id);
+                    delayed_action(_self, name(game_id), name("settle"), make_tuple(game_id), 0);
+                }
+            }
+            return owed;
+        }
+
+        /**
+         * What the stakes of a closed round pay under its payout rates, from the round's stakes in roundrisk
+         */
+        template<typename Payouts>
+        int64_t round_payout(uint64_t game_id, symbol sym, const Payouts& payouts) {
+            auto& risks = derived()._risks;
+            auto risk_iter = risks.find(sym.raw());
+            if (risk_iter == risks.end() || risk_iter->game_id != game_id) {
+                return 0;
+            }
+            int64_t total = 0;
+            for (const auto& entry : risk_iter->stakes) {
+                total += payouts.payout(asset(entry.amount, sym), entry.bet_type).amount;
+            }
+            return total;
+        }
+
+        template<typename Entry>
+        static void add_stake(vector<Entry>& entries, uint8_t bet_type, int64_t amount) {
+            auto entry = find_if(entries.begin(), entries.end(), [&](const auto& e) {
+                return e.bet_type == bet_type;
+            });
+            if (entry != entries.end()) {
+                entry->amount += amount;
+            } else {
+                entries.push_back(Entry{bet_type, amount});
+            }
+        }
+
+        /**
+         * Stakes indexed by bet type, the types past Result::BET_TYPES are added up in the last slot
+         */
+        template<typename Entry>
+        static vector<int64_t> stakes_by_type(const vector<Entry>& entries) {
+            vector<int64_t> stakes(Result::BET_TYPES + 1, 0);
+            for (const auto& entry : entries) {
+                stakes[min(entry.bet_type, Result::BET_TYPES)] += entry.amount;
+            }
+            return stakes;
+        }
+
+        void init_symbol(symbol sym) {
+            auto& games = derived()._games;
+            auto iter = games.find(sym.raw());
+            if (iter == games.end()) {
+                uint64_t next_id = derived()._counters.next(G_ID_GAME_ID);
+                games.emplace(_self, [&](auto &a) {
+                    a.id = next_id;
+                    a.symbol = sym;
+                    a.status = GAME_STATUS_STANDBY;
+                });
+                derived()._counters.save();
+            }
+        }
+
+        /**
+         * Settle the next SETTLE_CHUNK_SIZE bet rows of a revealed round from its stored payout rates. A chunk sends at
+         * most one payment transaction per bet row, so numbering them from the rows already settled keeps their sender
+         * ids apart.
+         */
+        void settle_chunk(uint64_t game_id) {
+            auto& counters = derived()._counters;
+            auto& settlements = derived()._settlements;
+            auto progress_iter = settlements.find(game_id);
+            eosio_assert(progress_iter != settlements.end(), "Round is not being settled");
+            typename Derived::settlement progress = *progress_iter;
+            decltype(Result::payouts) payouts;
+            payouts.load(progress.rates);
+            auto bet_index = derived()._bets.template get_index<name("bygameid")>();
+            payment_map result_map(RESULT_MAP_RESERVE);
+            result_map.largest_winner = progress.largest_winner.value;
+            result_map.win_amount = progress.win_amount;
+            typename Derived::history_log history(_self, counters.get(G_ID_HISTORY_ID), Config::HISTORY_SIZE);
+            uint64_t rows = 0;
+            int64_t paid = 0;
+            auto itr = bet_index.lower_bound(game_id);
+            for (; itr != bet_index.end() && itr->game_id == game_id && rows < SETTLE_CHUNK_SIZE; rows++) {
+                const auto& row = *itr;
+                asset row_payout = asset(0, row.total.symbol);
+                for (const auto& entry : row.bets) {
+                    typename Derived::bet bet_item{asset(entry.amount, row.total.symbol), entry.bet_type};
+                    asset payout = payouts.payout(bet_item.bet, bet_item.bet_type);
+                    row_payout += payout;
+                    if (progress.refund) {
+                        continue;
+                    }
+                    history.append(typename Derived::history{row.player, bet_item.bet, bet_item.bet_type, payout,
+                                                             progress.close_time, progress.result});
+                }
+                result_map.add_payment(row.player, row.total, row_payout, row.referer);
+                paid += row_payout.amount;
+                itr = bet_index.erase(itr);
+            }
+            bool drained = itr == bet_index.end() || itr->game_id != game_id;
+            history.flush();
+            counters.set(G_ID_HISTORY_ID, history.last_seq());
+            vector<batch_payment> payments;
+            payments.reserve(result_map.size());
+            for (const auto& item : result_map.sorted()) {
+                if (progress.refund) {
+                    payments.push_back(batch_payment{name(item.player), item.result.bet, item.result.payout,
+                                                     item.result.referer, true});
+                    continue;
+                }
+                result_map.track_largest_winner(item);
+                payments.push_back(batch_payment{name(item.player), item.result.bet / Config::REFERRAL_FACTOR,
+                                                 item.result.payout, item.result.referer});
+            }
+            make_batch_payment(_self, game_id, payments, progress.refund ? REFUND_MEMO : Config::WIN_MEMO,
+                               progress.refund ? REFUND_MEMO : Config::LOSE_MEMO, progress.settled);
+            counters.save();
+            if (!drained) {
+                settlements.modify(progress_iter, _self, [&](auto &a) {
+                    a.settled += rows;
+                    a.largest_winner = name(result_map.largest_winner);
+                    a.win_amount = result_map.win_amount;
+                    a.owed = max(a.owed - paid, (int64_t) 0);
+                    a.update_time = now();
+                });
+                delayed_action(_self, name(game_id), name("settle"), make_tuple(game_id), 0);
+                return;
+            }
+            settlements.erase(progress_iter);
+            if (progress.refund) {
+                return;
+            }
+            name winner_name = name(result_map.largest_winner);
+            table_modify(derived()._games, _self, progress.symbol.raw(), [&](auto &a) {
+                a.largest_winner = winner_name;
+                a.largest_win_amount = asset(result_map.win_amount, EOS_SYMBOL);
+            });
+        }
+    };
+}
+
+/**
+ * Constructor and actions of a round game contract NAME, which derives from round_game
+ */
+#define DEFINE_ROUND_GAME(NAME) \
     NAME::NAME(name receiver, name code, datastream<const char*> ds): \
-        contract(receiver, code, ds), \
+        round_game(receiver, code, ds), \
         _globals(_self, _self.value), \
+        _counters(_self, _globals, G_ID_START, G_ID_END), \
         _games(_self, _self.value), \
         _bets(_self, _self.value), \
-        _results(_self, _self.value), \
-        _bet_amount(_self, _self.value) { \
-    }
-
-#define DEFINE_INIT_FUNCTION(NAME) \
+        _risks(_self, _self.value), \
+        _settlements(_self, _self.value), \
+        _results(_self, _self.value) { \
+    } \
+    \
     void NAME::init() { \
-        require_auth(HOUSE_ACCOUNT); \
-        initsymbol(EOS_SYMBOL); \
-    }
-
-#define DEFINE_INIT_SYMBOL_FUNCTION(NAME) \
-    void NAME::initsymbol(symbol sym) { \
-        auto iter = _games.find(sym.raw()); \
-        if (iter == _games.end()) { \
-            uint64_t next_id = increment_global(_globals, G_ID_GAME_ID); \
-            _games.emplace(_self, [&](auto &a) { \
-                a.id = next_id; \
-                a.symbol = sym; \
-                a.status = GAME_STATUS_STANDBY; \
-            }); \
-        } \
-    }
-
-#define DEFINE_NEW_ROUND_FUNCTION(NAME) \
+        init_game(); \
+    } \
+    \
+    DEFINE_SET_COUNTER_GLOBAL(NAME) \
+    \
     void NAME::newround(symbol symbol_type) { \
-        require_auth(_self); \
-        uint32_t timestamp = now(); \
-        auto game_iter = _games.find(symbol_type.raw()); \
-        eosio_assert(game_iter->status == GAME_STATUS_STANDBY, "Round already started"); \
-        eosio_assert(timestamp >= game_iter->end_time, "Game resolving, please wait"); \
-        _games.modify(game_iter, _self, [&](auto &a) { \
-            a.end_time = timestamp + GAME_LENGTH; \
-            a.seed = create_seed(_self.value, a.id); \
-            a.status = GAME_STATUS_ACTIVE; \
-        }); \
-    }
-
-#define DEFINE_HARDCLOSE_FUNCTION(NAME) \
+        new_round(symbol_type); \
+    } \
+    \
     void NAME::hardclose(uint64_t game_id) { \
-        require_auth(_self); \
-        auto idx = _games.get_index<name("byid")>(); \
-        auto gm_pos = idx.find(game_id); \
-        uint64_t next_game_id = increment_global(_globals, G_ID_GAME_ID); \
-        idx.modify(gm_pos, _self, [&](auto &a) { \
-            a.id = next_game_id; \
-            a.status = GAME_STATUS_STANDBY; \
-            a.end_time = now(); \
-        }); \
-    }
-
-#define DEFINE_TRANSFER_FUNCTION(NAME) \
-    void NAME::transfer(name from, name to, asset quantity, string memo) { \
-        if (!check_transfer(this, from, to, quantity, memo)) { \
-            return; \
-        }; \
-        asset total_bet = quantity; \
-        auto bet_iter = _bet_amount.find(from.value); \
-        if (bet_iter != _bet_amount.end()) { \
-            total_bet += bet_iter->bet; \
-        } \
-        table_upsert(_bet_amount, _self, from.value, [&](auto &a) { \
-            a.player = from; \
-            a.bet = total_bet; \
-        }); \
-        transfer_to_house(_self, quantity, from, total_bet.amount); \
-        param_reader reader(memo); \
-        auto game_id = (uint64_t) atol( reader.next_param("Game ID cannot be empty!").c_str() ); \
-        auto referer = reader.get_referer(from); \
-        auto game_iter = _games.find(quantity.symbol.raw()); \
-        eosio_assert(game_iter->id == game_id, "Game is no longer active"); \
-        uint32_t timestamp = now(); \
-        uint8_t status = game_iter->status; \
-        switch (status) { \
-            case GAME_STATUS_STANDBY: { \
-                SEND_INLINE_ACTION(*this, newround, {_self, name("active")}, {quantity.symbol}); \
-                break; \
-            } \
-            case GAME_STATUS_ACTIVE: \
-                eosio_assert((timestamp + GAME_REVEAL_PRESET) < game_iter->end_time, "Game already finished, please wait for next round"); \
-                break; \
-            default: \
-                eosio_assert(false, "Invalid game state"); \
-        } \
-        asset total = asset(0, quantity.symbol); \
-        while(reader.has_next()) { \
-            uint8_t bet_type = (uint8_t) atoi( reader.next_param("Bet type cannot be empty!").c_str() ); \
-            uint64_t amount = (uint64_t) atoi( reader.next_param("Bet amount cannot be empty!").c_str() ); \
-            asset bet_amount(amount, quantity.symbol); \
-            eosio_assert(bet_amount.amount > 0, "Bet amount must be positive"); \
-            total += bet_amount; \
-            uint64_t next_bet_id = increment_global(_globals, G_ID_BET_ID); \
-            _bets.emplace(_self, [&](auto &a) { \
-                a.id = next_bet_id; \
-                a.game_id = game_id; \
-                a.player = from; \
-                a.referer = referer; \
-                a.bet = bet_amount; \
-                a.bet_type = bet_type; \
-            }); \
-        } \
-        eosio_assert(quantity == total, "bet amount does not match transfer amount"); \
+        hard_close(game_id); \
     } \
-
-#define DEFINE_REVEAL_FUNCTION(NAME, DISPLAYNAME, RESULT, REFERRAL_FACTOR) \
+    \
+    DEFINE_ROUTED_TRANSFER(NAME) \
+    \
+    void NAME::doBet(name from, asset quantity, const string& memo, bool routed) { \
+        place_bet(from, quantity, memo, routed); \
+    } \
+    \
     void NAME::reveal(uint64_t game_id, capi_signature signature) { \
-        auto idx = _games.get_index<name("byid")>(); \
-        auto gm_pos = idx.find(game_id); \
-        uint32_t timestamp = now(); \
-        \
-        eosio_assert(gm_pos != idx.end() && gm_pos->id == game_id, "reveal: game id does't exist!"); \
-        eosio_assert(gm_pos->status == GAME_STATUS_ACTIVE && (timestamp + GAME_REVEAL_PRESET) >= gm_pos->end_time, "Can not reveal yet"); \
-        randkeys_index random_keys(HOUSE_ACCOUNT, HOUSE_ACCOUNT.value); \
-        capi_public_key random_key = random_keys.get(0, "random key is not set").key; \
-        random random_gen = random_from_sig(random_key, gm_pos->seed, signature); \
-        doReveal(game_id, random_gen); \
-        delayed_action(_self, _self, name("newround"), make_tuple(gm_pos->symbol), GAME_RESOLVE_TIME); \
+        reveal_round(game_id, signature); \
     } \
     \
-    void NAME::doReveal(uint64_t game_id, random &random_gen) { \
-        auto idx = _games.get_index<name("byid")>(); \
-        auto gm_pos = idx.find(game_id); \
-        uint32_t timestamp = now(); \
-        RESULT result(random_gen); \
-        auto bet_index = _bets.get_index<name("bygameid")>(); \
-        map<uint64_t, pay_result> result_map; \
-        for (auto itr = bet_index.begin(); itr != bet_index.end(); itr++) { \
-            uint8_t bet_type = itr->bet_type; \
-            asset bet = itr->bet; \
-            asset payout = result.get_payout(*itr); \
-            auto result_itr = result_map.find(itr->player.value); \
-            if (result_itr == result_map.end()) { \
-                result_map[itr->player.value] = pay_result{bet, payout, itr->referer}; \
-            } else { \
-                result_itr->second.bet += bet; \
-                result_itr->second.payout += payout; \
-            } \
-        } \
-        history_table history(_self, _self.value); \
-        uint64_t history_id = get_global(_globals, G_ID_HISTORY_ID); \
-        for (auto itr = bet_index.begin(); itr != bet_index.end();) { \
-            uint8_t bet_type = itr->bet_type; \
-            asset bet = itr->bet; \
-            asset payout = result.get_payout(*itr); \
-            history_id++; \
-            uint64_t id = history_id % HISTORY_SIZE; \
-            table_upsert(history, _self, id, [&](auto &a) { \
-                a.id = id; \
-                a.history_id = history_id; \
-                a.player = itr->player; \
-                a.bet = bet; \
-                a.result = result.result; \
-                a.bet_type = bet_type; \
-                a.payout = payout; \
-                a.close_time = timestamp; \
-            }); \
-            itr = bet_index.erase(itr); \
-        } \
-        set_global(_globals, G_ID_HISTORY_ID, history_id); \
-        auto largest_winner = result_map.end(); \
-        int64_t win_amount = 0; \
-        for (auto itr = result_map.begin(); itr != result_map.end(); itr++) { \
-            auto current = itr->second; \
-            if (current.payout.amount > current.bet.amount && \
-                current.payout.amount > win_amount && \
-                current.payout.symbol == EOS_SYMBOL) { \
-                largest_winner = itr; \
-                win_amount = current.payout.amount; \
-            } \
-            make_payment(_self, name(itr->first), current.bet / REFERRAL_FACTOR, current.payout, current.referer, \
-                         current.payout.amount >= current.bet.amount ? \
-                        "[Dapp365] " #DISPLAYNAME " win!" : "[Dapp365] " #DISPLAYNAME " lose!" ); \
-        } \
-        uint64_t next_game_id = increment_global(_globals, G_ID_GAME_ID); \
-        name winner_name = largest_winner == result_map.end() ? name() : name(largest_winner->first); \
-        idx.modify(gm_pos, _self, [&](auto &a) { \
-            a.id = next_game_id; \
-            a.status = GAME_STATUS_STANDBY; \
-            a.end_time = timestamp + GAME_RESOLVE_TIME; \
-            a.largest_winner = winner_name; \
-            a.largest_win_amount = asset(win_amount, EOS_SYMBOL); \
-            result.update_game(a); \
-        }); \
-        for (auto itr = _bet_amount.begin(); itr != _bet_amount.end();) { \
-            itr = _bet_amount.erase(itr); \
-        } \
-        uint64_t result_index = increment_global_mod(_globals, G_ID_RESULT_ID, RESULT_SIZE); \
-        table_upsert(_results, _self, result_index, [&](auto &a) { \
-            a.id = result_index; \
-            a.game_id = game_id; \
-            a.result = result.roundResult; \
-        }); \
-        result.set_receipt(*this, game_id, gm_pos->seed); \
+    void NAME::settle(uint64_t game_id) { \
+        settle_round(game_id); \
     }
-
-#define DEFINE_STANDARD_FUNCTIONS(NAME) \
-        DEFINE_CONSTRUCTOR(NAME) \
-        DEFINE_INIT_FUNCTION(NAME) \
-        DEFINE_SET_GLOBAL(NAME) \
-        DEFINE_NEW_ROUND_FUNCTION(NAME) \
-        DEFINE_INIT_SYMBOL_FUNCTION(NAME) \
-        DEFINE_HARDCLOSE_FUNCTION(NAME) \
-        DEFINE_TRANSFER_FUNCTION(NAME)
\ No newline at end of file
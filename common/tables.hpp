@@ -1,10 +1,45 @@
 #pragma once
 
+#include <cstring>
 #include <eosiolib/eosio.hpp>
 
+#define TABLE_COMPARE_BUFFER        256
+
 namespace godapp {
     using namespace eosio;
 
+    /**
+     * Whether two rows pack to the same bytes, rows over TABLE_COMPARE_BUFFER bytes are taken as different
+     */
+    template<typename Row>
+    bool same_packed(const Row& left, const Row& right) {
+        size_t size = pack_size(left);
+        if (size != pack_size(right) || size > TABLE_COMPARE_BUFFER) {
+            return false;
+        }
+        char left_bytes[TABLE_COMPARE_BUFFER], right_bytes[TABLE_COMPARE_BUFFER];
+        datastream<char*> left_stream(left_bytes, size), right_stream(right_bytes, size);
+        left_stream << left;
+        right_stream << right;
+        return memcmp(left_bytes, right_bytes, size) == 0;
+    }
+
+    /**
+     * Modify for rows the updater often leaves as they are, such as admin settings set again to the same value. The
+     * updater runs on a copy and the row is only written if it changed. Only meant for rows the contract always pays
+     * for, the write is skipped only when payer is the contract and any other payer is written so it is not lost.
+     */
+    template<typename T, typename Iterator, typename Lambda>
+    void table_modify_changed(T& table, Iterator iter, const name& payer, Lambda&& updater){
+        auto row = *iter;
+        updater(row);
+        if (payer != table.get_code() || !same_packed(row, *iter)) {
+            table.modify(iter, payer, [&](auto& a) {
+                a = row;
+            });
+        }
+    }
+
     template<typename T, typename Lambda>
     void table_upsert(T& table, const name& payer, uint64_t key, Lambda&& updater){
         auto iter = table.find(key);
@@ -16,6 +51,20 @@ namespace godapp {
         }
     }
 
+    /**
+     * table_upsert that skips writing an existing row the updater left unchanged, see table_modify_changed
+     */
+    template<typename T, typename Lambda>
+    void table_upsert_changed(T& table, const name& payer, uint64_t key, Lambda&& updater){
+        auto iter = table.find(key);
+
+        if (iter == table.end()) {
+            table.emplace(payer, updater);
+        } else {
+            table_modify_changed(table, iter, payer, updater);
+        }
+    }
+
     template<typename T, typename Lambda>
     void table_insert(T& table, const name& payer, uint64_t key, Lambda updater){
         auto iter = table.find(key);
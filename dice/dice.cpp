@@ -50,15 +50,13 @@ namespace godapp {
 
 
 
-    void dice::transfer(name from, name to, asset quantity, string memo) {
-        if (!check_transfer(this, from, to, quantity, memo)) {
-            return;
-        };
+    DEFINE_ROUTED_TRANSFER(dice)
 
+    void dice::doBet(name from, asset quantity, const string& memo, bool routed) {
         param_reader reader(memo);
         auto bet_number = reader.next_param_i("Roll prediction cannot be empty!");
         eosio_assert(bet_number >= MIN_BET && bet_number <= MAX_BET, "bet number must between 1 to 97");
-        transfer_to_house(_self, quantity, from, reward_amount(quantity, bet_number).amount);
+        accept_bet(_self, routed, quantity, from, reward_amount(quantity, bet_number).amount);
 
         uint32_t _now = now();
         eosio::time_point_sec time = eosio::time_point_sec( _now );
@@ -89,7 +87,7 @@ namespace godapp {
         uint64_t roll_value = random_gen.generator(MAX_ROLL_NUM);
 
         asset payout;
-        asset bet_asset = activebets_itr->bet_asset;eo
+        asset bet_asset = activebets_itr->bet_asset;
         uint8_t bet_number = activebets_itr->bet_number;
         name player = activebets_itr->player;
 
@@ -56,9 +56,13 @@ namespace godapp {
         ACTION pay(uint64_t bet_id, name player, asset bet, asset payout, capi_checksum256 seed,
                 uint8_t bet_value, uint64_t roll_value, name referer);
         ACTION transfer(name from, name to, asset quantity, string memo);
+        ACTION placebet(name player, asset quantity, string memo);
 
         dice(name receiver, name code, datastream<const char *> ds);
+
+    private:
+        void doBet(name from, asset quantity, const string& memo, bool routed);
     };
 
-    EOSIO_ABI_EX(dice, (init)(transfer)(reveal)(pay))
+    EOSIO_ABI_EX(dice, (init)(transfer)(placebet)(reveal)(pay))
 }
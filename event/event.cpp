@@ -4,6 +4,7 @@
 
 #include "event.hpp"
 #include "../common/param_reader.hpp"
+#include "../common/payment_map.hpp"
 
 #define GLOBAL_ID_START         1001
 #define GLOBAL_ID_EVENT_ID      1001
@@ -25,8 +26,8 @@ namespace godapp {
         }
 
         param_reader reader(memo);
-        auto game_id = (uint64_t) atol( reader.next_param("Game ID cannot be empty!").c_str() );
-        auto bet_type = (uint8_t) atol( reader.next_param("Bet type cannot be empty").c_str() );
+        auto game_id = reader.next_param_i64("Game ID cannot be empty!");
+        auto bet_type = reader.next_param_i("Bet type cannot be empty");
 
         auto game_itr = _events.find(game_id);
         eosio_assert(game_itr != _events.end(), "Game does not exist");
@@ -115,11 +116,6 @@ namespace godapp {
         });
     }
 
-    struct pay_result {
-        asset bet;
-        asset payout;
-    };
-
     void event::resolve(uint64_t id, const std::string& event_name, uint8_t result, uint64_t payout, const std::string& memo) {
         require_auth(_self);
 
@@ -132,7 +128,7 @@ namespace godapp {
 
         auto idx = _active_bets.get_index<name("bygameid")>();
         asset total_payout(0, EOS_SYMBOL);
-        map<name, pay_result> result_map;
+        payment_map result_map;
         for (auto bet_itr = idx.find(id); bet_itr != idx.end(); bet_itr++) {
             if (bet_itr->game_id != id) {
                 break;
@@ -142,20 +138,14 @@ namespace godapp {
             asset payout_amount = (bet_type == result) ? (bet_asset * win_rate / 100) : asset(0, EOS_SYMBOL);
             total_payout += payout_amount;
 
-            auto result_itr = result_map.find(bet_itr->player);
-            if (result_itr == result_map.end()) {
-                result_map[bet_itr->player] = pay_result{bet_asset, payout_amount};
-            } else {
-                result_itr->second.bet += bet_asset;
-                result_itr->second.payout += payout_amount;
-            }
+            result_map.add_payment(bet_itr->player, bet_asset, payout_amount, name());
         }
         eosio_assert(payout == total_payout.amount, "Amount does not match");
 
-        for (auto & itr : result_map) {
-            auto current = itr.second;
-            delayed_action(_self, itr.first, name("payment"),
-                make_tuple(id, itr.first, event_itr->event_name, result, current.bet, current.payout), 0);
+        for (const auto& item : result_map.sorted()) {
+            name player(item.player);
+            delayed_action(_self, player, name("payment"),
+                make_tuple(id, player, event_itr->event_name, result, item.result.bet, item.result.payout), 0);
         }
 
         _events.modify(event_itr, _self, [&](auto &a) {
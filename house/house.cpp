@@ -79,7 +79,9 @@ namespace godapp {
         require_auth(_self);
 
         game_index games(_self, _self.value);
-        table_modify(games, _self, game.value, [&](auto &a) {
+        auto iter = games.find(game.value);
+        eosio_assert(iter != games.end(), "item does not exist");
+        table_modify_changed(games, iter, _self, [&](auto &a) {
             a.active = active;
         });
     }
@@ -94,7 +96,8 @@ namespace godapp {
     }
 
     /**
-     * Receive transfer from games, and check payment status
+     * Receive transfer from games, and check payment status. Players can also bet here directly with memo
+     * "bet,<game>,<game memo>", the bet is booked as if the game had forwarded it and handed to the game's placebet.
      */
     void house::transfer(name from, name to, asset quantity, string memo) {
         if (!check_transfer(this, from, to, quantity, memo, false)) {
@@ -106,53 +109,10 @@ namespace godapp {
 
         // if this is from a game
         if (game_itr != games.end()) {
-            eosio_assert(game_itr->active, "game is not active");
-
-            // check that the token is supported and amount is within limit, update record accordingly
-            token_index game_token(_self, from.value);
-            auto token_iter = game_token.find(quantity.symbol.raw());
-            game_token.modify(token_iter, _self, [&](auto &a) {
-                a.in += quantity.amount;
-                a.balance += quantity.amount;
-                a.play_times += 1;
-            });
-
-            // update the player table for book-keeping
-            player_record_index game_player(_self, _self.value);
-            name player = name(memo);
-            eosio_assert(is_account(player), "invalid player account");
-            // we only keep track of EOS cash flow
-            uint64_t amount = quantity.symbol == EOS_SYMBOL ? quantity.amount : 0;
-
-            auto player_iter = game_player.find(player.value);
-            if (player_iter == game_player.end()) {
-                game_player.emplace(_self, [&](auto &a) {
-                    a.player = player;
-                    a.in = amount;
-                    a.daily_in = amount;
-                    a.out = 0;
-                    a.play_times = 1;
-
-                    a.last_play_time = now();
-                    a.game_played_flag |= 1 << game_itr->id;
-                });
-            } else {
-                uint32_t timestamp = now();
-                // reset event play amount if it has past event (day) boundary
-                uint64_t daily_in = ((timestamp / EVENT_LENGTH) > (player_iter->last_play_time / EVENT_LENGTH)) ?
-                                    0 : player_iter->daily_in;
-                daily_in += amount;
-                game_player.modify(player_iter, _self, [&](auto &a) {
-                    a.in += amount;
-                    a.play_times += 1;
-                    a.last_play_time = timestamp;
-                    a.daily_in = daily_in;
-                    a.game_played_flag |= 1 << game_itr->id;
-                });
-            }
+            record_bet(*game_itr, name(memo), quantity);
         } else {
             param_reader reader(memo);
-            string target = reader.next_param("target can not be empty");
+            string_view target = reader.next_param("target can not be empty");
 
             if (target == "deposit") {
                 // this is a deposit for the game, increase the balance (payout limit) automatically
@@ -166,12 +126,75 @@ namespace godapp {
                         a.balance += quantity.amount;
                     });
                 }
+            } else if (target == "bet") {
+                // a bet routed through the house, the tokens stay here and the game only gets the bet
+                require_direct_transfer(from);
+                name game_name(reader.next_param("game can not be empty"));
+                auto routed_itr = games.find(game_name.value);
+                eosio_assert(routed_itr != games.end(), "game does not exist");
+                record_bet(*routed_itr, from, quantity);
+
+                action(permission_level{_self, name("active")}, game_name, name("placebet"),
+                       make_tuple(from, quantity, reader.rest())).send();
             } else {
                 eosio_assert(false, "invalid action");
             }
         }
     }
 
+    /**
+     * Book a bet a game took, on the game's token and the player record
+     * @param game_value The game the bet was made in
+     * @param player The player betting
+     * @param quantity Amount of the bet
+     */
+    void house::record_bet(const struct game& game_value, name player, asset quantity) {
+        eosio_assert(game_value.active, "game is not active");
+
+        // the game checks the bet limits, only make sure the token is supported here
+        token_index game_token(_self, game_value.name.value);
+        auto token_iter = game_token.find(quantity.symbol.raw());
+        eosio_assert(token_iter != game_token.end(), "token is not supported");
+        game_token.modify(token_iter, _self, [&](auto &a) {
+            a.in += quantity.amount;
+            a.balance += quantity.amount;
+            a.play_times += 1;
+        });
+
+        // update the player stats for book-keeping
+        eosio_assert(is_account(player), "invalid player account");
+        migrate_player(player);
+        player_stats_index game_player(_self, _self.value);
+        // we only keep track of EOS cash flow
+        uint64_t amount = quantity.symbol == EOS_SYMBOL ? quantity.amount : 0;
+
+        auto player_iter = game_player.find(player.value);
+        if (player_iter == game_player.end()) {
+            game_player.emplace(_self, [&](auto &a) {
+                a.player = player;
+                a.in = amount;
+                a.daily_in = amount;
+                a.play_times = 1;
+
+                a.last_play_time = now();
+                a.game_played_flag |= 1 << game_value.id;
+            });
+        } else {
+            uint32_t timestamp = now();
+            // reset event play amount if it has past event (day) boundary
+            uint64_t daily_in = ((timestamp / EVENT_LENGTH) > (player_iter->last_play_time / EVENT_LENGTH)) ?
+                                0 : player_iter->daily_in;
+            daily_in += amount;
+            game_player.modify(player_iter, _self, [&](auto &a) {
+                a.in += amount;
+                a.play_times += 1;
+                a.last_play_time = timestamp;
+                a.daily_in = daily_in;
+                a.game_played_flag |= 1 << game_value.id;
+            });
+        }
+    }
+
     /**
      * Pay player and referer on behalf of a game
      * @param game Name of the game
@@ -188,97 +211,402 @@ namespace godapp {
         game_index games(_self, _self.value);
         struct game game_value = games.get(game.value, "Game does not exist");
 
-        player_record_index game_player(_self, _self.value);
+        player_info_index players(_self, _self.value);
         token_index game_token(_self, game.value);
 
         auto token_iter = game_token.find(payout.symbol.raw());
         eosio_assert(token_iter != game_token.end(), "Token not supported");
 
-        int64_t pay_amount = payout.amount;
-        if (token_iter->balance < pay_amount || (payout.symbol == EOS_SYMBOL && (pay_amount - bet.amount) >= DELAYED_PAYMENT_LIMIT)) {
+        int64_t pay_amount = 0;
+        vector<referral_bonus> bonuses;
+        if (settle_payment(game_value, *token_iter, token_iter->balance, players, to, bet, payout, memo, referer,
+                           false, bonuses, pay_amount)) {
+            game_token.modify(token_iter, _self, [&](auto &a) {
+                a.out += pay_amount;
+                a.balance -= pay_amount;
+            });
+        }
+        accrue_referrals(bonuses);
+    }
+
+    /**
+     * Pay a list of players on behalf of a game, the token balance is loaded and written once for the whole batch
+     * @param game Name of the game
+     * @param payments Payments to make, all in the same token
+     * @param win_memo Memo for players whose payout covers their bet
+     * @param lose_memo Memo for the other players
+     */
+    void house::paybatch(name game, vector<batch_payment> payments, string win_memo, string lose_memo) {
+        require_auth(game);
+        if (payments.empty()) {
+            return;
+        }
+
+        game_index games(_self, _self.value);
+        struct game game_value = games.get(game.value, "Game does not exist");
+
+        player_info_index players(_self, _self.value);
+        token_index game_token(_self, game.value);
+
+        symbol sym = payments[0].payout.symbol;
+        auto token_iter = game_token.find(sym.raw());
+        eosio_assert(token_iter != game_token.end(), "Token not supported");
+
+        uint64_t balance = token_iter->balance;
+        int64_t total_amount = 0;
+        bool paid = false;
+        vector<referral_bonus> bonuses;
+        for (const auto& payment : payments) {
+            eosio_assert(payment.payout.symbol == sym, "All payments in a batch must use the same token");
+
+            int64_t pay_amount = 0;
+            const string& memo = payment.payout.amount >= payment.bet.amount ? win_memo : lose_memo;
+            if (settle_payment(game_value, *token_iter, balance, players, payment.player, payment.bet,
+                               payment.payout, memo, payment.referer, payment.refund, bonuses, pay_amount)) {
+                balance -= pay_amount;
+                total_amount += pay_amount;
+                paid = true;
+            }
+        }
+
+        if (paid) {
+            game_token.modify(token_iter, _self, [&](auto &a) {
+                a.out += total_amount;
+                a.balance -= total_amount;
+            });
+        }
+        accrue_referrals(bonuses);
+    }
+
+    /**
+     * Pay a player and the referer out of a game's token, or record the payment as unpaid if the balance cannot cover
+     * it or it's over the delayed payment limit. The caller updates the token row.
+     * @param game_value The game paying
+     * @param token_value Token row of the game
+     * @param balance Current balance of the token, may be ahead of token_value within a batch
+     * @param players Player info table
+     * @param refund Whether the payout returns the bet, a refund earns the referer no bonus
+     * @param bonuses Referral bonus owed to the referer is added here, the caller accrues the list
+     * @param pay_amount Set to the amount taken from the balance, including the referral bonus
+     * @return Whether the payment was made
+     */
+    bool house::settle_payment(const struct game& game_value, const token& token_value, uint64_t balance,
+                               player_info_index& players, name to, asset bet, asset payout, const string& memo,
+                               name referer, bool refund, vector<referral_bonus>& bonuses, int64_t& pay_amount) {
+        pay_amount = payout.amount;
+        if (balance < pay_amount || (payout.symbol == EOS_SYMBOL && (pay_amount - bet.amount) >= DELAYED_PAYMENT_LIMIT)) {
             unpaid_index delayed = unpaid_index(_self, _self.value);
             delayed.emplace(_self, [&](auto &a) {
                 a.id = delayed.available_primary_key();
-                a.game = game;
+                a.game = game_value.name;
                 a.player = to;
                 a.bet = bet;
                 a.payout = payout;
                 a.referer = referer;
             });
-        } else {
-            player_record_index game_player(_self, _self.value);
-            if (payout.symbol == EOS_SYMBOL) {
-                if (referer.value == _self.value) {
-                    referer = name(0);
-                }
-                auto player_iter = game_player.find(to.value);
-                if (player_iter != game_player.end()) {
-                    if (player_iter->referer.value != 0) {
-                        referer = player_iter->referer;
-                    }
+            pay_amount = 0;
+            return false;
+        }
 
-                    asset refer_bonus(0, EOS_SYMBOL);
-                    if (referer.value != 0) {
-                        refer_bonus = bet * REFERRAL_BONUS / 1000;
-                        if (game_value.id == BULLFIGHT_ID) {
-                            refer_bonus /= 5;
-                        }
-                        pay_amount += refer_bonus.amount;
-                        if (refer_bonus.amount > 0) {
-                            INLINE_ACTION_SENDER(eosio::token, transfer)(token_iter->contract, {_self, name("active")}, {_self, referer, refer_bonus, "Dapp365 Referral Bonus"} );
-                        }
-                    }
+        if (payout.symbol == EOS_SYMBOL) {
+            if (referer.value == _self.value) {
+                referer = name(0);
+            }
+            migrate_player(to);
+            auto player_iter = players.find(to.value);
+            if (player_iter == players.end()) {
+                // a player who only bet so far has no info row yet
+                player_iter = players.emplace(_self, [&](auto &a) {
+                    a.player = to;
+                });
+            }
+            if (player_iter->referer.value != 0) {
+                referer = player_iter->referer;
+            }
 
-                    game_player.modify(player_iter, _self, [&](auto &a) {
-                        a.out += payout.amount;
-                        a.referer = referer;
-                        a.referer_payout += refer_bonus.amount;
+            asset refer_bonus(0, EOS_SYMBOL);
+            if (referer.value != 0 && !refund) {
+                refer_bonus = bet * REFERRAL_BONUS / 1000;
+                if (game_value.id == BULLFIGHT_ID) {
+                    refer_bonus /= 5;
+                }
+                pay_amount += refer_bonus.amount;
+                if (refer_bonus.amount > 0) {
+                    auto bonus = find_if(bonuses.begin(), bonuses.end(), [&](const referral_bonus& b) {
+                        return b.referer == referer;
                     });
+                    if (bonus != bonuses.end()) {
+                        bonus->amount += refer_bonus.amount;
+                    } else {
+                        bonuses.push_back(referral_bonus{referer, refer_bonus.amount});
+                    }
                 }
             }
 
-            game_token.modify(token_iter, _self, [&](auto &a) {
-                a.out += pay_amount;
-                a.balance -= pay_amount;
+            players.modify(player_iter, _self, [&](auto &a) {
+                a.out += payout.amount;
+                a.referer = referer;
+                a.referer_payout += refer_bonus.amount;
             });
+        }
+
+        if (payout.amount > 0) {
+            INLINE_ACTION_SENDER(eosio::token, transfer)(token_value.contract, {_self, name("active")}, {_self, to, payout, memo} );
+        }
+        return true;
+    }
 
-            if (payout.amount > 0) {
-                INLINE_ACTION_SENDER(eosio::token, transfer)(token_iter->contract, {_self, name("active")}, {_self, to, payout, memo} );
+    /**
+     * Add referral bonuses to the referers' balances, one row write per referer. A balance reaching the sweep
+     * threshold is sent right away, otherwise it waits for claimref.
+     * @param bonuses EOS bonus per referer
+     */
+    void house::accrue_referrals(const vector<referral_bonus>& bonuses) {
+        if (bonuses.empty()) {
+            return;
+        }
+
+        uint64_t threshold = referral_config_singleton(_self, _self.value).get_or_default().sweep_threshold;
+        referral_balance_index balances(_self, _self.value);
+        for (const auto& bonus : bonuses) {
+            auto iter = balances.find(bonus.referer.value);
+            uint64_t balance = bonus.amount + (iter == balances.end() ? 0 : iter->balance);
+            uint64_t swept = (threshold > 0 && balance >= threshold) ? balance : 0;
+
+            if (iter == balances.end()) {
+                balances.emplace(_self, [&](auto &a) {
+                    a.referer = bonus.referer;
+                    a.balance = balance - swept;
+                    a.claimed = swept;
+                });
+            } else {
+                balances.modify(iter, _self, [&](auto &a) {
+                    a.balance = balance - swept;
+                    a.claimed += swept;
+                });
+            }
+
+            if (swept > 0) {
+                INLINE_ACTION_SENDER(eosio::token, transfer)(EOS_TOKEN_CONTRACT, {_self, name("active")},
+                    {_self, bonus.referer, asset(swept, EOS_SYMBOL), "Dapp365 Referral Bonus"} );
             }
         }
     }
 
+    /**
+     * Send a referer the referral bonus accrued so far
+     * @param referer The referer claiming
+     */
+    void house::claimref(name referer) {
+        require_auth(referer);
+
+        referral_balance_index balances(_self, _self.value);
+        auto iter = balances.find(referer.value);
+        eosio_assert(iter != balances.end() && iter->balance > 0, "No referral bonus to claim");
+
+        asset amount(iter->balance, EOS_SYMBOL);
+        balances.modify(iter, _self, [&](auto &a) {
+            a.claimed += a.balance;
+            a.balance = 0;
+        });
+
+        INLINE_ACTION_SENDER(eosio::token, transfer)(EOS_TOKEN_CONTRACT, {_self, name("active")},
+            {_self, referer, amount, "Dapp365 Referral Bonus"} );
+    }
+
+    /**
+     * Set the balance at which accrued referral bonuses are sent without a claim, 0 turns the sweep off
+     */
+    void house::setrefsweep(uint64_t threshold) {
+        require_auth(_self);
+
+        referral_config_singleton config(_self, _self.value);
+        config.set(referral_config{threshold}, _self);
+    }
+
     void house::settleunpaid(uint64_t id, bool pay) {
+        settlebatch(vector<uint64_t>{id}, 0, 0, pay, 1);
+    }
+
+    /**
+     * Pay or drop unpaid records in one go, transfers are made once per player and token, token rows and player
+     * rows are written once each
+     * @param ids Records to settle, if empty the records with first_id <= id <= last_id are settled instead
+     * @param pay Whether to pay the records or only drop them
+     * @param budget Maximum number of records to settle. A range stops there and leaves the rest for the next call,
+     * a list of more ids than that is refused
+     */
+    void house::settlebatch(vector<uint64_t> ids, uint64_t first_id, uint64_t last_id, bool pay, uint32_t budget) {
         require_auth(_self);
+        eosio_assert(budget > 0, "budget must be positive");
+
+        struct game_outflow {
+            name game;
+            symbol sym;
+            name contract;
+            int64_t amount;
+        };
+        struct player_transfer {
+            name player;
+            name contract;
+            asset amount;
+        };
+        vector<game_outflow> outflows;
+        vector<player_transfer> transfers;
 
         unpaid_index delayed = unpaid_index(_self, _self.value);
-        auto itr = delayed.find(id);
-        eosio_assert(itr != delayed.end(), "Unpaid record does not exist");
+        auto settle = [&](auto itr) {
+            if (!pay) {
+                return delayed.erase(itr);
+            }
 
-        if (pay) {
-            name player = itr->player;
             asset payout = itr->payout;
+            auto outflow = find_if(outflows.begin(), outflows.end(), [&](const game_outflow& o) {
+                return o.game == itr->game && o.sym == payout.symbol;
+            });
+            if (outflow == outflows.end()) {
+                token_index game_token(_self, itr->game.value);
+                auto token_iter = game_token.find(payout.symbol.raw());
+                eosio_assert(token_iter != game_token.end(), "Token not supported");
+                outflows.push_back(game_outflow{itr->game, payout.symbol, token_iter->contract, 0});
+                outflow = outflows.end() - 1;
+            }
+            outflow->amount += payout.amount;
 
-            player_record_index game_player(_self, _self.value);
-            auto player_iter = game_player.find(player.value);
-            game_player.modify(player_iter, _self, [&](auto &a) {
-                a.out += payout.amount;
+            name contract = outflow->contract;
+            auto existing = find_if(transfers.begin(), transfers.end(), [&](const player_transfer& t) {
+                return t.player == itr->player && t.contract == contract && t.amount.symbol == payout.symbol;
             });
+            if (existing == transfers.end()) {
+                transfers.push_back(player_transfer{itr->player, contract, payout});
+            } else {
+                existing->amount += payout;
+            }
+            return delayed.erase(itr);
+        };
+
+        if (!ids.empty()) {
+            eosio_assert(ids.size() <= budget, "more ids than the budget allows");
+            for (uint64_t id : ids) {
+                auto itr = delayed.find(id);
+                eosio_assert(itr != delayed.end(), "Unpaid record does not exist");
+                settle(itr);
+            }
+        } else {
+            uint32_t count = 0;
+            for (auto itr = delayed.lower_bound(first_id); itr != delayed.end() && itr->id <= last_id && count < budget;
+                 count++) {
+                itr = settle(itr);
+            }
+        }
 
-            token_index game_token(_self, itr->game.value);
-            auto token_iter = game_token.find(payout.symbol.raw());
-            eosio_assert(token_iter != game_token.end(), "Token not supported");
+        for (const auto& outflow : outflows) {
+            token_index game_token(_self, outflow.game.value);
+            auto token_iter = game_token.find(outflow.sym.raw());
             game_token.modify(token_iter, _self, [&](auto &a) {
-                a.out = payout.amount;
-                a.balance -= payout.amount;
+                a.out += outflow.amount;
+                a.balance -= outflow.amount;
             });
+        }
+
+        player_info_index players(_self, _self.value);
+        for (const auto& item : transfers) {
+            // settled payouts count towards the player's out in every token, as settleunpaid always did
+            migrate_player(item.player);
+            auto player_iter = players.find(item.player.value);
+            if (player_iter == players.end()) {
+                players.emplace(_self, [&](auto &a) {
+                    a.player = item.player;
+                    a.out = item.amount.amount;
+                });
+            } else {
+                players.modify(player_iter, _self, [&](auto &a) {
+                    a.out += item.amount.amount;
+                });
+            }
 
-            if (payout.amount > 0) {
-                INLINE_ACTION_SENDER(eosio::token, transfer)(token_iter->contract, {_self, name("active")},
-                    {_self, player, payout, "Dapp365 settle payment"} );
+            if (item.amount.amount > 0) {
+                INLINE_ACTION_SENDER(eosio::token, transfer)(item.contract, {_self, name("active")},
+                    {_self, item.player, item.amount, "Dapp365 settle payment"} );
             }
         }
-        delayed.erase(itr);
+    }
+
+    /**
+     * Move players from the old playertable into playerstats and playerinfo, at most limit rows per call. Migrated rows
+     * are erased, so calling again continues where the last call stopped until the old table is empty.
+     * @param limit Maximum number of players to move
+     */
+    void house::migrateplay(uint32_t limit) {
+        require_auth(_self);
+
+        player_record_index legacy(_self, _self.value);
+        uint32_t count = 0;
+        auto iter = legacy.begin();
+        for (; iter != legacy.end() && count < limit; count++) {
+            split_record(*iter);
+            iter = legacy.erase(iter);
+        }
+        if (iter == legacy.end() && !players_migrated()) {
+            migration_singleton(_self, _self.value).set(migration_state{true}, _self);
+        }
+    }
+
+    /**
+     * Whether migrateplay has emptied the old playertable, read once per action
+     */
+    bool house::players_migrated() {
+        if (!_migration_loaded) {
+            _players_migrated = migration_singleton(_self, _self.value).get_or_default().players_done;
+            _migration_loaded = true;
+        }
+        return _players_migrated;
+    }
+
+    /**
+     * Move one player out of the old playertable if it is still there, before any of its new rows are touched. Once
+     * the migration is done the old table is not looked at any more.
+     */
+    void house::migrate_player(name player) {
+        if (players_migrated()) {
+            return;
+        }
+        player_record_index legacy(_self, _self.value);
+        auto iter = legacy.find(player.value);
+        if (iter != legacy.end()) {
+            split_record(*iter);
+            legacy.erase(iter);
+        }
+    }
+
+    void house::split_record(const player_record& record) {
+        player_stats_index stats(_self, _self.value);
+        if (stats.find(record.player.value) == stats.end()) {
+            stats.emplace(_self, [&](auto &a) {
+                a.player = record.player;
+                a.in = record.in;
+                a.play_times = record.play_times;
+                a.last_play_time = record.last_play_time;
+                a.daily_in = record.daily_in;
+                a.game_played_flag = record.game_played_flag;
+            });
+        }
+
+        player_info_index players(_self, _self.value);
+        if (players.find(record.player.value) == players.end()) {
+            players.emplace(_self, [&](auto &a) {
+                a.player = record.player;
+                a.out = record.out;
+                a.referer = record.referer;
+                a.referer_payout = record.referer_payout;
+                a.bonus_claimed = record.bonus_claimed;
+                a.chest_opened = record.chest_opened;
+                a.bonus_point = record.bonus_point;
+                a.bonus_payout = record.bonus_payout;
+                a.daily_flag = record.daily_flag;
+                a.daily_claimed = record.daily_claimed;
+            });
+        }
     }
 
     void house::updatetoken(name game, symbol token, name contract, uint64_t min, uint64_t max_payout, uint64_t balance) {
@@ -309,18 +637,19 @@ namespace godapp {
     void house::setreferer(name player, name referer) {
         require_auth(player);
 
-        player_record_index game_player(_self, _self.value);
-        auto itr = game_player.find(player.value);
+        migrate_player(player);
+        player_info_index players(_self, _self.value);
+        auto itr = players.find(player.value);
         eosio_assert(referer.value != player.value && referer.value != _self.value, "Invalid Player Name");
-        if (itr != game_player.end()) {
+        if (itr != players.end()) {
             if (referer.value != itr->referer.value) {
-                game_player.modify(itr, _self, [&](auto &a) {
+                players.modify(itr, _self, [&](auto &a) {
                     a.referer = referer;
                     a.referer_payout = 0;
                 });
             }
         } else {
-            game_player.emplace(_self, [&](auto &a) {
+            players.emplace(_self, [&](auto &a) {
                 a.player = player;
                 a.referer = referer;
             });
@@ -350,41 +679,53 @@ namespace godapp {
         require_auth(player);
         uint64_t reward_mask = ((uint32_t) 1) << reward_type;
 
-        player_record_index game_player(_self, _self.value);
-        auto itr = game_player.find(player.value);
-        eosio_assert(itr != game_player.end(), "Player does not exist");
-        eosio_assert((itr->bonus_claimed & reward_mask) == 0, "reward already claimed");
+        migrate_player(player);
+        player_info_index players(_self, _self.value);
+        player_stats_index stats(_self, _self.value);
+        auto itr = players.find(player.value);
+        auto stats_itr = stats.find(player.value);
+        eosio_assert(itr != players.end() || stats_itr != stats.end(), "Player does not exist");
+        eosio_assert(itr == players.end() || (itr->bonus_claimed & reward_mask) == 0, "reward already claimed");
 
+        uint64_t game_played_flag = stats_itr == stats.end() ? 0 : stats_itr->game_played_flag;
         uint64_t points = 0;
         switch (reward_type) {
             case SET_REFERER:
-                if (itr->referer.value != 0) {
+                if (itr != players.end() && itr->referer.value != 0) {
                     points = 50;
                 }
                 break;
             case PLAY_ANY_GAME:
-                if (itr->game_played_flag != 0) {
+                if (game_played_flag != 0) {
                     points = 20;
                 }
                 break;
             case PLAY_ALL_GAMES:
-                if ((itr->game_played_flag & 1022) == 1022) {
+                if ((game_played_flag & 1022) == 1022) {
                     points = 20;
                 }
                 break;
             default:
                 if (reward_type >= TOTAL_PLAYED_START && reward_type <= TOTAL_PLAYED_END) {
                     const played_reward& reward = rewards[reward_type - TOTAL_PLAYED_START];
-                    if (itr->in >= reward.amount * 10000) {
+                    if (stats_itr != stats.end() && stats_itr->in >= reward.amount * 10000) {
                         points = reward.points;
                     }
                 }
         }
 
-        game_player.modify(itr, _self, [&](auto &a) {
-            a.bonus_point += points;
-            a.bonus_claimed |= reward_mask;
-        });
+        if (itr == players.end()) {
+            players.emplace(_self, [&](auto &a) {
+                a.player = player;
+                a.bonus_point = points;
+                a.bonus_claimed = reward_mask;
+            });
+        } else {
+            players.modify(itr, _self, [&](auto &a) {
+                a.bonus_point += points;
+                a.bonus_claimed |= reward_mask;
+            });
+        }
     }
 
     struct chest_reward {
@@ -404,9 +745,10 @@ namespace godapp {
         chest_reward reward_value = chest_amount[chest_type];
         asset reward(reward_value.amount, EOS_SYMBOL);
 
-        player_record_index game_player(_self, _self.value);
-        auto itr = game_player.find(player.value);
-        eosio_assert(itr != game_player.end(), "Player does not exist");
+        migrate_player(player);
+        player_info_index players(_self, _self.value);
+        auto itr = players.find(player.value);
+        eosio_assert(itr != players.end(), "Player does not exist");
         eosio_assert(itr->bonus_point >= reward_value.limit, "Not enough bonus point");
         eosio_assert((itr->chest_opened & reward_mask) == 0, "Reward already claimed");
 
@@ -414,7 +756,7 @@ namespace godapp {
         uint64_t roll = rng.generator(101);
         reward += reward * roll / 100;
 
-        game_player.modify(itr, _self, [&](auto &a) {
+        players.modify(itr, _self, [&](auto &a) {
             a.out += reward.amount;
             a.bonus_payout += reward.amount;
             a.chest_opened |= reward_mask;
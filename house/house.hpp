@@ -7,6 +7,7 @@
 #include <eosiolib/asset.hpp>
 #include <eosiolib/eosio.hpp>
 #include <string>
+#include <algorithm>
 #include "../common/contracts.hpp"
 
 namespace godapp {
@@ -16,7 +17,7 @@ namespace godapp {
     CONTRACT house: public contract {
     public:
         TABLE game {
-            name name;
+            eosio::name name;
             uint64_t id;
             bool active;
 
@@ -45,6 +46,7 @@ namespace godapp {
         };
         typedef multi_index<name("tokens"), token> token_index;
 
+        // a player's row before it was split into player_stats and player_info, only read by the migration
         TABLE player_record {
             name player;
             uint64_t in;
@@ -72,6 +74,42 @@ namespace godapp {
             indexed_by< name("byreferer"), const_mem_fun<player_record, uint64_t, &player_record::byreferer> >
         > player_record_index;
 
+        // the part of a player written on every bet
+        TABLE player_stats {
+            name player;
+            uint64_t in = 0;
+            uint64_t play_times = 0;
+            uint32_t last_play_time = 0;
+            uint64_t daily_in = 0;
+            uint64_t game_played_flag = 0;
+
+            uint64_t primary_key() const {return player.value;};
+        };
+        typedef multi_index<name("playerstats"), player_stats> player_stats_index;
+
+        // payouts, referral and rewards of a player
+        TABLE player_info {
+            name player;
+            uint64_t out = 0;
+
+            name referer;
+            uint64_t referer_payout = 0;
+
+            uint32_t bonus_claimed = 0;
+            uint32_t chest_opened = 0;
+            uint64_t bonus_point = 0;
+            uint64_t bonus_payout = 0;
+
+            uint64_t daily_flag = 0;
+            uint64_t daily_claimed = 0;
+
+            uint64_t primary_key() const {return player.value;};
+            uint64_t byreferer() const {return referer.value;}
+        };
+        typedef multi_index<name("playerinfo"), player_info,
+            indexed_by< name("byreferer"), const_mem_fun<player_info, uint64_t, &player_info::byreferer> >
+        > player_info_index;
+
         TABLE delayed_payment {
             uint64_t id;
             name game;
@@ -84,6 +122,31 @@ namespace godapp {
         };
         typedef multi_index<name("unpaid"), delayed_payment> unpaid_index;
 
+        TABLE referral_balance {
+            name referer;
+            uint64_t balance;
+            uint64_t claimed;
+
+            uint64_t primary_key() const {return referer.value;};
+        };
+        typedef multi_index<name("refbalance"), referral_balance> referral_balance_index;
+
+        TABLE referral_config {
+            uint64_t sweep_threshold = 0;
+        };
+        typedef singleton<name("refconfig"), referral_config> referral_config_singleton;
+
+        // set by migrateplay once the old playertable is empty
+        TABLE migration_state {
+            bool players_done = false;
+        };
+        typedef singleton<name("migration"), migration_state> migration_singleton;
+
+        struct referral_bonus {
+            name referer;
+            int64_t amount;
+        };
+
         house(name receiver, name code, datastream<const char *> ds): contract(receiver, code, ds) {
         }
 
@@ -93,6 +156,7 @@ namespace godapp {
         ACTION setrandkey(capi_public_key key);
         ACTION transfer(name from, name to, asset quantity, string memo);
         ACTION pay(name game, name to, asset bet, asset payout, string memo, name referer);
+        ACTION paybatch(name game, vector<batch_payment> payments, string win_memo, string lose_memo);
         ACTION updatetoken(name game, symbol token, name contract, uint64_t min, uint64_t max, uint64_t balance);
         ACTION cleartoken(name game);
 
@@ -100,10 +164,27 @@ namespace godapp {
         ACTION claimreward(name player, uint8_t reward_type);
         ACTION openchest(name player, uint8_t chest_type);
         ACTION settleunpaid(uint64_t id, bool pay);
+        ACTION settlebatch(vector<uint64_t> ids, uint64_t first_id, uint64_t last_id, bool pay, uint32_t budget);
+        ACTION claimref(name referer);
+        ACTION setrefsweep(uint64_t threshold);
+        ACTION migrateplay(uint32_t limit);
+
+    private:
+        void record_bet(const struct game& game_value, name player, asset quantity);
+        bool settle_payment(const struct game& game_value, const token& token_value, uint64_t balance,
+                            player_info_index& players, name to, asset bet, asset payout, const string& memo,
+                            name referer, bool refund, vector<referral_bonus>& bonuses, int64_t& pay_amount);
+        bool _migration_loaded = false;
+        bool _players_migrated = false;
+
+        bool players_migrated();
+        void migrate_player(name player);
+        void split_record(const player_record& record);
+        void accrue_referrals(const vector<referral_bonus>& bonuses);
     };
 
 #ifdef DEFINE_DISPATCHER
-    EOSIO_ABI_EX(house, (transfer)(addgame)(updatetoken)(updategame)(pay)(setactive)(setrandkey)(cleartoken)
-        (claimreward)(setreferer)(openchest)(settleunpaid))
+    EOSIO_ABI_EX(house, (transfer)(addgame)(updatetoken)(updategame)(pay)(paybatch)(setactive)(setrandkey)(cleartoken)
+        (claimreward)(setreferer)(openchest)(settleunpaid)(settlebatch)(claimref)(setrefsweep)(migrateplay))
 #endif
 }
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "tester.hpp"
+
+/**
+ * Per-action cost benchmark: plays the hot paths of every game through the emulator and reports, per contract action,
+ * the wall time, database calls by type, bytes serialized and the contract heap high-water mark.
+ *
+ * usage: native_benchmark [-r rounds] [-b bets per round] [--csv] [contract module dir]
+ */
+using namespace godapp::native;
+
+#define BET_AMOUNT          1000
+#define BETS_PER_TRANSFER   10
+#define ROUND_WAIT          60
+#define RESOLVE_WAIT        30
+
+struct round_game {
+    const char* contract;
+    uint64_t id;
+    std::vector<uint8_t> bet_types;
+};
+
+static std::vector<round_game> ROUND_GAMES = {
+    {"baccarat", 5, {1, 2, 3, 4, 5}},
+    {"cbaccarat", 6, {1, 2, 4, 8, 16}},
+    {"roulette", 7, {1, 13, 37, 38, 39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49}},
+    {"quick3", 8, {3, 10, 11, 18, 19, 20, 21, 22, 23, 24, 25}},
+    {"bullfight", 9, {1, 2, 3, 4}},
+    {"redblack", 10, {1, 2, 4}},
+};
+
+class benchmark {
+public:
+    benchmark(const std::string& contract_dir, uint32_t rounds, uint32_t bets):
+        _tester(contract_dir), _rounds(rounds), _bets(bets), _signature_count(0) {
+    }
+
+    void setup() {
+        _tester.deploy(HOUSE_ACCOUNT, "house");
+        _tester.issue(HOUSE_ACCOUNT, asset(1000000000000, EOS_SYMBOL));
+
+        capi_public_key key;
+        memset(&key, 0, sizeof(key));
+        _tester.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("setrandkey"), key);
+
+        add_game("dice", 1);
+        add_game("blackjack", 2);
+        add_game("scratch", 3);
+        add_game("slots", 4);
+        for (const auto& game : ROUND_GAMES) {
+            add_game(game.contract, game.id);
+        }
+
+        // every player has a referer, so payouts go through the referral bonus
+        name referer("referer");
+        _tester.create_account(referer);
+        uint32_t players = std::max<uint32_t>(1, (_bets + BETS_PER_TRANSFER - 1) / BETS_PER_TRANSFER);
+        for (uint32_t i = 0; i < players; i++) {
+            name player = player_name(i);
+            _tester.create_account(player);
+            _tester.issue(player, asset(1000000000, EOS_SYMBOL));
+            _tester.push(player, HOUSE_ACCOUNT, name("setreferer"), player, referer);
+            _players.push_back(player);
+        }
+        settle();
+
+        // only measure the games, not the setup
+        _tester.get_chain().reset_stats();
+    }
+
+    void run() {
+        for (uint32_t round = 1; round <= _rounds; round++) {
+            play_dice(round);
+            play_blackjack(round);
+            play_scratch(round);
+            play_slots(round);
+        }
+        for (const auto& game : ROUND_GAMES) {
+            for (uint32_t round = 0; round < _rounds; round++) {
+                play_round(game);
+            }
+        }
+    }
+
+    void report(bool csv) const {
+        const auto& stats = _tester.get_chain().stats();
+        if (csv) {
+            printf("action,calls,avg_us,db_calls,bytes_written,bytes_read,bytes_sent,heap_peak");
+            for (int i = 0; i < DB_CALL_COUNT; i++) {
+                printf(",%s", db_call_name((db_call) i));
+            }
+            printf(",unchanged_updates\n");
+        } else {
+            printf("%u rounds, %u bets per round game reveal, values are per call except heap peak\n\n", _rounds,
+                   _bets);
+            printf("%-24s %7s %10s %9s %10s %10s %10s %10s\n", "action", "calls", "avg us", "db calls", "written",
+                   "read", "sent", "heap peak");
+        }
+
+        for (const auto& entry : stats) {
+            const action_stats& s = entry.second;
+            if (s.calls == 0) {
+                continue;
+            }
+            std::string action = name_to_string(entry.first.first) + "::" + name_to_string(entry.first.second);
+            double calls = (double) s.calls;
+            if (csv) {
+                printf("%s,%llu,%.3f,%.1f,%.1f,%.1f,%.1f,%zu", action.c_str(), (unsigned long long) s.calls,
+                       s.wall_ns / calls / 1000, s.total_db_calls() / calls, s.bytes_written / calls,
+                       s.bytes_read / calls, s.bytes_sent / calls, s.heap_peak);
+                for (int i = 0; i < DB_CALL_COUNT; i++) {
+                    printf(",%.1f", s.db_calls[i] / calls);
+                }
+                printf(",%.1f\n", s.unchanged_updates / calls);
+                continue;
+            }
+
+            printf("%-24s %7llu %10.2f %9.1f %10.1f %10.1f %10.1f %10zu\n", action.c_str(),
+                   (unsigned long long) s.calls, s.wall_ns / calls / 1000, s.total_db_calls() / calls,
+                   s.bytes_written / calls, s.bytes_read / calls, s.bytes_sent / calls, s.heap_peak);
+            std::string breakdown;
+            for (int i = 0; i < DB_CALL_COUNT; i++) {
+                if (s.db_calls[i] > 0) {
+                    char buffer[64];
+                    snprintf(buffer, sizeof(buffer), " %s=%.1f", db_call_name((db_call) i), s.db_calls[i] / calls);
+                    breakdown += buffer;
+                }
+            }
+            if (s.unchanged_updates > 0) {
+                char buffer[64];
+                snprintf(buffer, sizeof(buffer), " unchanged_updates=%.1f", s.unchanged_updates / calls);
+                breakdown += buffer;
+            }
+            if (!breakdown.empty()) {
+                printf("%24s%s\n", "", breakdown.c_str());
+            }
+        }
+
+        for (const auto& failure : _tester.get_chain().failed_deferred()) {
+            fprintf(stderr, "deferred transaction failed: %s\n", failure.c_str());
+        }
+    }
+
+private:
+    static name player_name(uint32_t index) {
+        std::string str = "player";
+        for (int i = 0; i < 6; i++) {
+            str += (char) ('a' + index % 26);
+            index /= 26;
+        }
+        return name(str);
+    }
+
+    void add_game(const char* contract, uint64_t id) {
+        name game(contract);
+        _tester.deploy(game, contract);
+        _tester.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("addgame"), game, id);
+        // the deferred init reuses the house's sender id, it has to run before the next game is added
+        _tester.produce_block();
+        _tester.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("updatetoken"), game, EOS_SYMBOL, EOS_TOKEN_CONTRACT,
+                     (uint64_t) BET_AMOUNT, (uint64_t) 100000000, (uint64_t) 10000000000);
+    }
+
+    capi_signature next_signature() {
+        capi_signature sig;
+        _signature_count++;
+        for (size_t i = 0; i < sizeof(sig.data); i++) {
+            sig.data[i] = (uint8_t) (i * 31 + _signature_count * 17 + (_signature_count >> 8));
+        }
+        return sig;
+    }
+
+    /**
+     * Run deferred transactions (payments, new rounds) until nothing is left
+     */
+    void settle(uint32_t seconds = 0) {
+        _tester.produce_block(seconds);
+        while (_tester.produce_block(RESOLVE_WAIT) > 0) {
+        }
+    }
+
+    void play_dice(uint64_t bet_id) {
+        name dice("dice");
+        _tester.transfer(_players[0], dice, asset(BET_AMOUNT * 10, EOS_SYMBOL), "50,,");
+        _tester.push(HOUSE_ACCOUNT, dice, name("reveal"), bet_id, next_signature());
+        settle();
+    }
+
+    void play_blackjack(uint64_t game_id) {
+        name blackjack("blackjack");
+        _tester.transfer(_players[0], blackjack, asset(BET_AMOUNT * 10, EOS_SYMBOL), "0,,");
+        _tester.push(HOUSE_ACCOUNT, blackjack, name("resolve"), game_id, next_signature());
+        try {
+            // stand, unless the opening hand already closed the game
+            _tester.push(_players[0], blackjack, name("playeraction"), _players[0], game_id, (uint8_t) 4);
+            _tester.push(HOUSE_ACCOUNT, blackjack, name("resolve"), game_id, next_signature());
+        } catch (const assert_failure&) {
+        }
+        settle();
+    }
+
+    void play_scratch(uint64_t round) {
+        name scratch("scratch");
+        uint64_t card_id = round * 2 - 1;
+        _tester.transfer(_players[0], scratch, asset(BET_AMOUNT * 2, EOS_SYMBOL), "0,1000,2,");
+        _tester.push(HOUSE_ACCOUNT, scratch, name("reveal"), card_id, next_signature());
+        // the receipt is deferred under the player's sender id, let it run before scratching the next card
+        settle();
+        _tester.push(_players[0], scratch, name("play"), _players[0], (uint8_t) 0, name());
+        _tester.push(HOUSE_ACCOUNT, scratch, name("reveal"), card_id + 1, next_signature());
+        settle();
+    }
+
+    void play_slots(uint64_t game_id) {
+        name slots("slots");
+        _tester.transfer(_players[0], slots, asset(BET_AMOUNT, EOS_SYMBOL), ",");
+        _tester.push(HOUSE_ACCOUNT, slots, name("reveal"), game_id, next_signature());
+        settle();
+    }
+
+    uint64_t current_game_id(name game) const {
+        std::vector<char> row;
+        bool found = _tester.get_chain().get_row(game.value, game.value, name("activegame").value,
+                                                 EOS_SYMBOL.raw(), row);
+        if (!found || row.size() < sizeof(uint64_t)) {
+            throw std::runtime_error(game.to_string() + " has no active game");
+        }
+        uint64_t id;
+        memcpy(&id, row.data(), sizeof(id));
+        return id;
+    }
+
+    /**
+     * Queue the configured number of bets spread over the players, then reveal the round
+     */
+    void play_round(const round_game& game) {
+        name contract(game.contract);
+        uint64_t game_id = current_game_id(contract);
+
+        uint32_t placed = 0;
+        for (size_t player = 0; placed < _bets; player++) {
+            std::string memo = std::to_string(game_id) + ",,";
+            uint32_t count = std::min<uint32_t>(BETS_PER_TRANSFER, _bets - placed);
+            for (uint32_t i = 0; i < count; i++) {
+                uint8_t bet_type = game.bet_types[(placed + i) % game.bet_types.size()];
+                memo += std::to_string(bet_type) + "," + std::to_string(BET_AMOUNT) + ",";
+            }
+            _tester.transfer(_players[player], contract, asset(BET_AMOUNT * count, EOS_SYMBOL), memo);
+            placed += count;
+        }
+
+        _tester.produce_block(ROUND_WAIT);
+        _tester.push(HOUSE_ACCOUNT, contract, name("reveal"), game_id, next_signature());
+        settle();
+    }
+
+    tester _tester;
+    uint32_t _rounds;
+    uint32_t _bets;
+    uint32_t _signature_count;
+    std::vector<name> _players;
+};
+
+int main(int argc, char** argv) {
+    std::string contract_dir = NATIVE_CONTRACT_DIR;
+    uint32_t rounds = 20;
+    uint32_t bets = 100;
+    bool csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = (uint32_t) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            bets = (uint32_t) atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            contract_dir = argv[i];
+        }
+    }
+
+    benchmark bench(contract_dir, rounds, bets);
+    try {
+        bench.setup();
+        bench.run();
+    } catch (const std::exception& e) {
+        fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    bench.report(csv);
+    return 0;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "../common/cards.hpp"
+
+/**
+ * Check that card_deck deals the same cards as the draw it replaced, so rounds revealed before it still replay. The
+ * including source defines card_t as the games dealing that deck do.
+ */
+#define CARD_CHECK_STREAMS      20000
+#define CARD_CHECK_DEAL         52          // cards dealt on a stream that does not deal the whole deck
+
+namespace godapp {
+namespace native {
+    /**
+     * The draw before card_deck: bump a number drawn from the remaining cards past the sorted cards already dealt
+     */
+    inline card_t reference_draw(random& random_gen, vector<card_t>& exclude, card_t max_number) {
+        size_t total_dealt = exclude.size();
+        auto card = (card_t) random_gen.generator(max_number - total_dealt);
+
+        sort(exclude.begin(), exclude.end());
+        for (card_t i: exclude) {
+            if (card >= i) {
+                card++;
+            } else {
+                break;
+            }
+        }
+        return card;
+    }
+
+    inline random card_check_stream(uint64_t stream, uint8_t version) {
+        uint64_t words[2] = {0x636172645f64656bull, stream};
+        capi_checksum256 digest;
+        ::sha256(reinterpret_cast<const char*>(words), sizeof(words), &digest);
+        return random(digest, version);
+    }
+
+    /**
+     * Deal cards both ways on CARD_CHECK_STREAMS streams of each random version
+     * @param full_every Every full_every-th stream deals the whole deck, the others CARD_CHECK_DEAL cards
+     * @return Whether every card matched
+     */
+    inline bool check_card_deck(card_t cards, uint32_t full_every) {
+        try {
+            for (uint8_t version : {RANDOM_VERSION_1, RANDOM_VERSION_2}) {
+                for (uint64_t stream = 0; stream < CARD_CHECK_STREAMS; stream++) {
+                    random reference_gen = card_check_stream(stream, version);
+                    random deck_gen = card_check_stream(stream, version);
+                    vector<card_t> dealt;
+                    card_deck deck(cards);
+                    uint32_t deal = min((uint32_t) cards, (uint32_t) CARD_CHECK_DEAL);
+                    if (stream % full_every == 0) {
+                        deal = cards;
+                    }
+                    for (uint32_t i = 0; i < deal; i++) {
+                        card_t expected = reference_draw(reference_gen, dealt, cards);
+                        dealt.push_back(expected);
+                        card_t card = deck.draw(deck_gen);
+                        if (card != expected) {
+                            printf("card_deck: %u cards, version %u, stream %llu dealt %u as card %u, expected %u\n",
+                                   (uint32_t) cards, version, (unsigned long long) stream, (uint32_t) card, i,
+                                   (uint32_t) expected);
+                            return false;
+                        }
+                    }
+                }
+                printf("card_deck: %u cards, version %u, %u streams dealt the same\n", (uint32_t) cards, version,
+                       CARD_CHECK_STREAMS);
+            }
+            return true;
+        } catch (const std::exception& e) {
+            printf("card_deck: %s\n", e.what());
+            return false;
+        }
+    }
+}
+}
@@ -0,0 +1,880 @@
+#include "chain.hpp"
+
+#include <dlfcn.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+#define MAX_INLINE_ACTION_DEPTH     4
+#define MAX_MEMO_SIZE               256
+#define GENESIS_TIME                1556668800ull
+
+namespace godapp {
+namespace native {
+    static const uint64_t TOKEN_ACCOUNT = string_to_name("eosio.token");
+    static const uint64_t TRANSFER_ACTION = string_to_name("transfer");
+
+    static void fail(const std::string& msg) {
+        throw assert_failure(msg);
+    }
+
+    uint64_t string_to_name(const char* str) {
+        size_t len = strlen(str);
+        uint64_t value = 0;
+        for (size_t i = 0; i <= 12; i++) {
+            uint64_t c = 0;
+            if (i < len) {
+                char ch = str[i];
+                if (ch >= 'a' && ch <= 'z') {
+                    c = (uint64_t) (ch - 'a') + 6;
+                } else if (ch >= '1' && ch <= '5') {
+                    c = (uint64_t) (ch - '1') + 1;
+                }
+            }
+            if (i < 12) {
+                value |= (c & 0x1f) << (64 - 5 * (i + 1));
+            } else {
+                value |= c & 0x0f;
+            }
+        }
+        return value;
+    }
+
+    std::string name_to_string(uint64_t value) {
+        static const char* charmap = ".12345abcdefghijklmnopqrstuvwxyz";
+        std::string str(13, '.');
+        uint64_t tmp = value;
+        for (uint32_t i = 0; i <= 12; i++) {
+            str[12 - i] = charmap[tmp & (i == 0 ? 0x0f : 0x1f)];
+            tmp >>= (i == 0 ? 4 : 5);
+        }
+        size_t last = str.find_last_not_of('.');
+        str.erase(last == std::string::npos ? 0 : last + 1);
+        return str;
+    }
+
+    const char* db_call_name(db_call call) {
+        static const char* names[DB_CALL_COUNT] = {
+            "db_store_i64", "db_update_i64", "db_remove_i64", "db_get_i64", "db_next_i64", "db_previous_i64",
+            "db_find_i64", "db_lowerbound_i64", "db_upperbound_i64", "db_end_i64",
+            "db_idx64_store", "db_idx64_update", "db_idx64_remove", "db_idx64_next", "db_idx64_previous",
+            "db_idx64_find_primary", "db_idx64_find_secondary", "db_idx64_lowerbound", "db_idx64_upperbound",
+            "db_idx64_end"
+        };
+        return names[call];
+    }
+
+    uint64_t action_stats::total_db_calls() const {
+        uint64_t total = 0;
+        for (int i = 0; i < DB_CALL_COUNT; i++) {
+            total += db_calls[i];
+        }
+        return total;
+    }
+
+    //###############    Serialization  ######################
+    class reader {
+    public:
+        reader(const char* data, size_t size): _data(data), _size(size), _pos(0) {}
+
+        void read(void* target, size_t size) {
+            if (_pos + size > _size) {
+                fail("datastream attempted to read past the end");
+            }
+            memcpy(target, _data + _pos, size);
+            _pos += size;
+        }
+
+        template<typename T>
+        T read() {
+            T value;
+            read(&value, sizeof(T));
+            return value;
+        }
+
+        uint32_t read_varuint() {
+            uint64_t value = 0;
+            uint8_t byte = 0;
+            uint32_t shift = 0;
+            do {
+                byte = read<uint8_t>();
+                value |= (uint64_t) (byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            return (uint32_t) value;
+        }
+
+        size_t position() const {
+            return _pos;
+        }
+
+    private:
+        const char* _data;
+        size_t _size;
+        size_t _pos;
+    };
+
+    static void write_varuint(std::vector<char>& out, uint32_t value) {
+        uint64_t val = value;
+        do {
+            uint8_t byte = uint8_t(val) & 0x7f;
+            val >>= 7;
+            byte |= ((val > 0) << 7);
+            out.push_back((char) byte);
+        } while (val);
+    }
+
+    template<typename T>
+    static void write(std::vector<char>& out, T value) {
+        const char* bytes = reinterpret_cast<const char*>(&value);
+        out.insert(out.end(), bytes, bytes + sizeof(T));
+    }
+
+    static action_data read_action(reader& in) {
+        action_data act;
+        act.account = in.read<uint64_t>();
+        act.name = in.read<uint64_t>();
+        uint32_t auth_count = in.read_varuint();
+        for (uint32_t i = 0; i < auth_count; i++) {
+            uint64_t actor = in.read<uint64_t>();
+            uint64_t permission = in.read<uint64_t>();
+            act.authorization.push_back({actor, permission});
+        }
+        act.data.resize(in.read_varuint());
+        if (!act.data.empty()) {
+            in.read(act.data.data(), act.data.size());
+        }
+        return act;
+    }
+
+    std::vector<char> pack_action(const action_data& act) {
+        std::vector<char> out;
+        write(out, act.account);
+        write(out, act.name);
+        write_varuint(out, act.authorization.size());
+        for (const auto& auth : act.authorization) {
+            write(out, auth.actor);
+            write(out, auth.permission);
+        }
+        write_varuint(out, act.data.size());
+        out.insert(out.end(), act.data.begin(), act.data.end());
+        return out;
+    }
+
+    action_data unpack_action(const char* data, size_t size, size_t* consumed) {
+        reader in(data, size);
+        action_data act = read_action(in);
+        if (consumed) {
+            *consumed = in.position();
+        }
+        return act;
+    }
+
+    //###############    Iterator cache  ######################
+    template<typename Table>
+    int32_t chain::iterator_cache<Table>::end_of(Table* t) {
+        auto itr = table_ends.find(t);
+        if (itr != table_ends.end()) {
+            return itr->second;
+        }
+        int32_t end_iterator = -((int32_t) end_tables.size()) - 2;
+        end_tables.push_back(t);
+        table_ends[t] = end_iterator;
+        return end_iterator;
+    }
+
+    template<typename Table>
+    Table* chain::iterator_cache<Table>::table_of_end(int32_t iterator) const {
+        size_t index = (size_t) (-(iterator + 2));
+        if (iterator >= -1 || index >= end_tables.size()) {
+            fail("not a valid end iterator");
+        }
+        return end_tables[index];
+    }
+
+    template<typename Table>
+    int32_t chain::iterator_cache<Table>::add(Table* t, uint64_t primary) {
+        auto key = std::make_pair(t, primary);
+        auto itr = lookup.find(key);
+        if (itr != lookup.end()) {
+            return itr->second;
+        }
+        int32_t iterator = (int32_t) iterators.size();
+        iterators.push_back(key);
+        lookup[key] = iterator;
+        return iterator;
+    }
+
+    template<typename Table>
+    const std::pair<Table*, uint64_t>& chain::iterator_cache<Table>::get(int32_t iterator) const {
+        if (iterator < 0 || (size_t) iterator >= iterators.size()) {
+            fail("invalid iterator");
+        }
+        if (iterators[iterator].first == nullptr) {
+            fail("dereference of deleted object");
+        }
+        return iterators[iterator];
+    }
+
+    template<typename Table>
+    void chain::iterator_cache<Table>::remove(int32_t iterator) {
+        auto& entry = iterators[iterator];
+        lookup.erase(entry);
+        entry.first = nullptr;
+    }
+
+    template<typename Table>
+    void chain::iterator_cache<Table>::clear() {
+        end_tables.clear();
+        table_ends.clear();
+        iterators.clear();
+        lookup.clear();
+    }
+
+    //###############    Chain  ######################
+    chain::chain(): _now(GENESIS_TIME * 1000000), _block_num(1), _block_prefix(0x5ca1ab1e) {
+        create_account(string_to_name("eosio"));
+        create_account(TOKEN_ACCOUNT);
+    }
+
+    chain& chain::instance() {
+        static chain instance;
+        return instance;
+    }
+
+    void chain::create_account(uint64_t account) {
+        _accounts.insert(account);
+    }
+
+    bool chain::is_account(uint64_t account) const {
+        return _accounts.count(account) > 0;
+    }
+
+    void chain::set_code(uint64_t account, apply_function apply) {
+        create_account(account);
+        _code[account] = apply;
+    }
+
+    void chain::load_contract(uint64_t account, const std::string& module_path) {
+        void* handle = dlopen(module_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (handle == nullptr) {
+            throw std::runtime_error(dlerror());
+        }
+        auto apply = reinterpret_cast<apply_function>(dlsym(handle, "apply"));
+        if (apply == nullptr) {
+            throw std::runtime_error(module_path + " does not export apply()");
+        }
+        set_code(account, apply);
+    }
+
+    void chain::issue(uint64_t account, int64_t amount, uint64_t symbol) {
+        _balances[std::make_pair(account, symbol)] += amount;
+    }
+
+    int64_t chain::get_balance(uint64_t account, uint64_t symbol) const {
+        auto itr = _balances.find(std::make_pair(account, symbol));
+        return itr == _balances.end() ? 0 : itr->second;
+    }
+
+    void chain::produce_block(uint32_t seconds) {
+        // blocks are half a second apart, the prefix only needs to change from block to block
+        _now += (uint64_t) seconds * 1000000 + 500000;
+        _block_num++;
+        _block_prefix = _block_prefix * 1103515245u + 12345u;
+    }
+
+    chain::state chain::snapshot() const {
+        return state{_tables, _indexes, _balances, _deferred};
+    }
+
+    void chain::restore(state&& saved) {
+        _table_iterators.clear();
+        _index_iterators.clear();
+        _tables = std::move(saved.tables);
+        _indexes = std::move(saved.indexes);
+        _balances = std::move(saved.balances);
+        _deferred = std::move(saved.deferred);
+    }
+
+    void chain::push_transaction(const std::vector<action_data>& actions) {
+        state saved = snapshot();
+        std::vector<action_data> previous = std::move(_transaction);
+        _transaction = actions;
+        try {
+            for (const auto& act : actions) {
+                execute_action(act, 0);
+            }
+        } catch (...) {
+            _transaction = std::move(previous);
+            restore(std::move(saved));
+            throw;
+        }
+        _transaction = std::move(previous);
+    }
+
+    void chain::execute_action(const action_data& act, uint32_t depth) {
+        if (depth > MAX_INLINE_ACTION_DEPTH) {
+            fail("max inline action depth per transaction reached");
+        }
+
+        // the receiver runs first, then everyone notified through require_recipient, then the inline actions
+        std::vector<uint64_t> notified{act.account};
+        std::vector<action_data> inline_actions;
+        for (size_t i = 0; i < notified.size(); i++) {
+            apply_context context{&act, notified[i], &notified, &inline_actions};
+            apply_context* parent = _context;
+            _context = &context;
+            _table_iterators.clear();
+            _index_iterators.clear();
+            try {
+                apply(act, notified[i]);
+            } catch (const exit_request&) {
+                // eosio_exit finishes the action normally
+            } catch (...) {
+                _context = parent;
+                throw;
+            }
+            _context = parent;
+        }
+
+        for (const auto& inline_action : inline_actions) {
+            execute_action(inline_action, depth + 1);
+        }
+    }
+
+    void chain::apply(const action_data& act, uint64_t receiver) {
+        auto itr = _code.find(receiver);
+        if (itr != _code.end()) {
+            action_stats& stats = _stats[std::make_pair(receiver, act.name)];
+            action_stats* parent = _current_stats;
+            _current_stats = &stats;
+            size_t heap_start = contract_heap.current;
+            contract_heap.peak = heap_start;
+            auto start = std::chrono::steady_clock::now();
+
+            contract_heap.tracking = true;
+            try {
+                itr->second(receiver, act.account, act.name);
+            } catch (...) {
+                contract_heap.tracking = false;
+                _current_stats = parent;
+                throw;
+            }
+            contract_heap.tracking = false;
+
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            stats.calls++;
+            stats.wall_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+            stats.heap_peak = std::max(stats.heap_peak, contract_heap.peak - heap_start);
+            _current_stats = parent;
+        } else if (receiver == TOKEN_ACCOUNT) {
+            apply_token(act, receiver);
+        }
+    }
+
+    /**
+     * Minimal eosio.token: only transfer is supported, balances are seeded with issue()
+     */
+    void chain::apply_token(const action_data& act, uint64_t receiver) {
+        if (act.account != receiver) {
+            return;
+        }
+        if (act.name != TRANSFER_ACTION) {
+            fail("eosio.token action not supported: " + name_to_string(act.name));
+        }
+
+        reader in(act.data.data(), act.data.size());
+        uint64_t from = in.read<uint64_t>();
+        uint64_t to = in.read<uint64_t>();
+        int64_t amount = in.read<int64_t>();
+        uint64_t symbol = in.read<uint64_t>();
+        std::string memo(in.read_varuint(), '\0');
+        if (!memo.empty()) {
+            in.read(&memo[0], memo.size());
+        }
+
+        require_auth(from);
+        if (from == to) {
+            fail("cannot transfer to self");
+        }
+        if (!is_account(to)) {
+            fail("to account does not exist");
+        }
+        if (amount <= 0) {
+            fail("must transfer positive quantity");
+        }
+        if (memo.size() > MAX_MEMO_SIZE) {
+            fail("memo has more than 256 bytes");
+        }
+
+        int64_t& from_balance = _balances[std::make_pair(from, symbol)];
+        if (from_balance < amount) {
+            fail("overdrawn balance");
+        }
+        from_balance -= amount;
+        _balances[std::make_pair(to, symbol)] += amount;
+
+        require_recipient(from);
+        require_recipient(to);
+    }
+
+    size_t chain::run_deferred() {
+        size_t executed = 0;
+        while (true) {
+            auto itr = _deferred.begin();
+            while (itr != _deferred.end() && itr->execute_at > _now) {
+                itr++;
+            }
+            if (itr == _deferred.end()) {
+                break;
+            }
+
+            deferred_transaction trx = std::move(*itr);
+            _deferred.erase(itr);
+            try {
+                push_transaction(trx.actions);
+            } catch (const assert_failure& e) {
+                // nodeos would send an onerror to the sender, none of the games handle it
+                _failed_deferred.push_back(name_to_string(trx.sender) + ": " + e.what());
+            }
+            executed++;
+        }
+        return executed;
+    }
+
+    //###############    Action context  ######################
+    const action_data& chain::current_action() const {
+        if (_context == nullptr) {
+            fail("no action is being executed");
+        }
+        return *_context->act;
+    }
+
+    uint64_t chain::current_receiver() const {
+        if (_context == nullptr) {
+            fail("no action is being executed");
+        }
+        return _context->receiver;
+    }
+
+    void chain::require_auth(uint64_t account, uint64_t permission) const {
+        for (const auto& auth : current_action().authorization) {
+            if (auth.actor == account && (permission == 0 || auth.permission == permission)) {
+                return;
+            }
+        }
+        fail("missing authority of " + name_to_string(account));
+    }
+
+    bool chain::has_auth(uint64_t account) const {
+        for (const auto& auth : current_action().authorization) {
+            if (auth.actor == account) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void chain::require_recipient(uint64_t account) {
+        current_action();
+        for (uint64_t notified : *_context->notified) {
+            if (notified == account) {
+                return;
+            }
+        }
+        _context->notified->push_back(account);
+    }
+
+    void chain::send_inline(const char* data, size_t size) {
+        current_action();
+        _context->inline_actions->push_back(unpack_action(data, size));
+        if (_current_stats) {
+            _current_stats->bytes_sent += size;
+        }
+    }
+
+    void chain::send_deferred(uint128_t sender_id, uint64_t payer, const char* data, size_t size, bool replace) {
+        uint64_t sender = current_receiver();
+        if (_current_stats) {
+            _current_stats->bytes_sent += size;
+        }
+
+        reader in(data, size);
+        in.read<uint32_t>();                // expiration
+        in.read<uint16_t>();                // ref_block_num
+        in.read<uint32_t>();                // ref_block_prefix
+        in.read_varuint();                  // max_net_usage_words
+        in.read<uint8_t>();                 // max_cpu_usage_ms
+        uint32_t delay_sec = in.read_varuint();
+
+        deferred_transaction trx{sender, sender_id, payer, _now + (uint64_t) delay_sec * 1000000, {}};
+        uint32_t context_free_count = in.read_varuint();
+        for (uint32_t i = 0; i < context_free_count; i++) {
+            read_action(in);
+        }
+        uint32_t action_count = in.read_varuint();
+        for (uint32_t i = 0; i < action_count; i++) {
+            trx.actions.push_back(read_action(in));
+        }
+
+        for (auto itr = _deferred.begin(); itr != _deferred.end(); itr++) {
+            if (itr->sender == sender && itr->sender_id == sender_id) {
+                if (!replace) {
+                    fail("deferred transaction with the same sender_id and payer already exists");
+                }
+                _deferred.erase(itr);
+                break;
+            }
+        }
+        _deferred.push_back(std::move(trx));
+    }
+
+    bool chain::cancel_deferred(uint128_t sender_id) {
+        uint64_t sender = current_receiver();
+        for (auto itr = _deferred.begin(); itr != _deferred.end(); itr++) {
+            if (itr->sender == sender && itr->sender_id == sender_id) {
+                _deferred.erase(itr);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int chain::get_action(uint32_t type, uint32_t index, char* buffer, size_t size) const {
+        // there are no context free actions in the emulated transactions
+        if (type != 1 || index >= _transaction.size()) {
+            return -1;
+        }
+        std::vector<char> packed = pack_action(_transaction[index]);
+        if (size == 0) {
+            return (int) packed.size();
+        }
+        size_t copy_size = std::min(size, packed.size());
+        memcpy(buffer, packed.data(), copy_size);
+        return (int) copy_size;
+    }
+
+    //###############    Primary tables  ######################
+    bool chain::get_row(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t id,
+                        std::vector<char>& value) const {
+        auto itr = _tables.find(table_key{code, scope, table_name});
+        if (itr == _tables.end()) {
+            return false;
+        }
+        auto row_itr = itr->second.rows.find(id);
+        if (row_itr == itr->second.rows.end()) {
+            return false;
+        }
+        value = row_itr->second.value;
+        return true;
+    }
+
+    chain::table* chain::find_table(uint64_t code, uint64_t scope, uint64_t table_name) {
+        auto itr = _tables.find(table_key{code, scope, table_name});
+        return itr == _tables.end() ? nullptr : &itr->second;
+    }
+
+    int32_t chain::db_store_i64(uint64_t scope, uint64_t table_name, uint64_t payer, uint64_t id,
+                                const void* data, uint32_t len) {
+        count(DB_STORE);
+        uint64_t code = current_receiver();
+        if (payer == 0) {
+            fail("must specify a valid account to pay for new record");
+        }
+        table& t = _tables[table_key{code, scope, table_name}];
+        t.code = code;
+        if (t.rows.count(id) > 0) {
+            fail("key already exists in table " + name_to_string(table_name));
+        }
+        const char* bytes = static_cast<const char*>(data);
+        t.rows[id] = row{payer, std::vector<char>(bytes, bytes + len)};
+        if (_current_stats) {
+            _current_stats->bytes_written += len;
+        }
+        return _table_iterators.add(&t, id);
+    }
+
+    void chain::db_update_i64(int32_t iterator, uint64_t payer, const void* data, uint32_t len) {
+        count(DB_UPDATE);
+        const auto& entry = _table_iterators.get(iterator);
+        if (entry.first->code != current_receiver()) {
+            fail("db access violation");
+        }
+        row& r = entry.first->rows.at(entry.second);
+        const char* bytes = static_cast<const char*>(data);
+        if (_current_stats) {
+            _current_stats->bytes_written += len;
+            if (r.value.size() == len && std::equal(bytes, bytes + len, r.value.begin())) {
+                _current_stats->unchanged_updates++;
+            }
+        }
+        r.value.assign(bytes, bytes + len);
+        if (payer != 0) {
+            r.payer = payer;
+        }
+    }
+
+    void chain::db_remove_i64(int32_t iterator) {
+        count(DB_REMOVE);
+        const auto& entry = _table_iterators.get(iterator);
+        if (entry.first->code != current_receiver()) {
+            fail("db access violation");
+        }
+        entry.first->rows.erase(entry.second);
+        _table_iterators.remove(iterator);
+    }
+
+    int32_t chain::db_get_i64(int32_t iterator, void* data, uint32_t len) {
+        count(DB_GET);
+        const auto& entry = _table_iterators.get(iterator);
+        const row& r = entry.first->rows.at(entry.second);
+        uint32_t size = (uint32_t) r.value.size();
+        if (len == 0) {
+            return (int32_t) size;
+        }
+        uint32_t copy_size = std::min(len, size);
+        memcpy(data, r.value.data(), copy_size);
+        if (_current_stats) {
+            _current_stats->bytes_read += copy_size;
+        }
+        return (int32_t) copy_size;
+    }
+
+    int32_t chain::db_next_i64(int32_t iterator, uint64_t* primary) {
+        count(DB_NEXT);
+        if (iterator < -1) {
+            return -1;
+        }
+        const auto entry = _table_iterators.get(iterator);
+        auto itr = entry.first->rows.upper_bound(entry.second);
+        if (itr == entry.first->rows.end()) {
+            return _table_iterators.end_of(entry.first);
+        }
+        *primary = itr->first;
+        return _table_iterators.add(entry.first, itr->first);
+    }
+
+    int32_t chain::db_previous_i64(int32_t iterator, uint64_t* primary) {
+        count(DB_PREVIOUS);
+        table* t = nullptr;
+        std::map<uint64_t, row>::iterator itr;
+        if (iterator < -1) {
+            t = _table_iterators.table_of_end(iterator);
+            itr = t->rows.end();
+        } else {
+            const auto entry = _table_iterators.get(iterator);
+            t = entry.first;
+            itr = t->rows.lower_bound(entry.second);
+        }
+        if (itr == t->rows.begin()) {
+            return -1;
+        }
+        itr--;
+        *primary = itr->first;
+        return _table_iterators.add(t, itr->first);
+    }
+
+    int32_t chain::db_find_i64(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t id) {
+        count(DB_FIND);
+        table* t = find_table(code, scope, table_name);
+        if (t == nullptr) {
+            return -1;
+        }
+        if (t->rows.count(id) == 0) {
+            return _table_iterators.end_of(t);
+        }
+        return _table_iterators.add(t, id);
+    }
+
+    int32_t chain::db_lowerbound_i64(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t id) {
+        count(DB_LOWERBOUND);
+        table* t = find_table(code, scope, table_name);
+        if (t == nullptr) {
+            return -1;
+        }
+        auto itr = t->rows.lower_bound(id);
+        if (itr == t->rows.end()) {
+            return _table_iterators.end_of(t);
+        }
+        return _table_iterators.add(t, itr->first);
+    }
+
+    int32_t chain::db_upperbound_i64(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t id) {
+        count(DB_UPPERBOUND);
+        table* t = find_table(code, scope, table_name);
+        if (t == nullptr) {
+            return -1;
+        }
+        auto itr = t->rows.upper_bound(id);
+        if (itr == t->rows.end()) {
+            return _table_iterators.end_of(t);
+        }
+        return _table_iterators.add(t, itr->first);
+    }
+
+    int32_t chain::db_end_i64(uint64_t code, uint64_t scope, uint64_t table_name) {
+        count(DB_END);
+        table* t = find_table(code, scope, table_name);
+        return t == nullptr ? -1 : _table_iterators.end_of(t);
+    }
+
+    //###############    Secondary uint64_t indexes  ######################
+    chain::index64* chain::find_index(uint64_t code, uint64_t scope, uint64_t table_name) {
+        auto itr = _indexes.find(table_key{code, scope, table_name});
+        return itr == _indexes.end() ? nullptr : &itr->second;
+    }
+
+    int32_t chain::index_iterator(index64* index, std::set<std::pair<uint64_t, uint64_t>>::const_iterator itr) {
+        if (itr == index->entries.end()) {
+            return _index_iterators.end_of(index);
+        }
+        return _index_iterators.add(index, itr->second);
+    }
+
+    int32_t chain::db_idx64_store(uint64_t scope, uint64_t table_name, uint64_t payer, uint64_t id,
+                                  uint64_t secondary) {
+        count(IDX64_STORE);
+        uint64_t code = current_receiver();
+        index64& index = _indexes[table_key{code, scope, table_name}];
+        index.code = code;
+        if (index.by_primary.count(id) > 0) {
+            fail("secondary key already exists for primary key");
+        }
+        index.entries.insert(std::make_pair(secondary, id));
+        index.by_primary[id] = std::make_pair(secondary, payer);
+        return _index_iterators.add(&index, id);
+    }
+
+    void chain::db_idx64_update(int32_t iterator, uint64_t payer, uint64_t secondary) {
+        count(IDX64_UPDATE);
+        const auto& entry = _index_iterators.get(iterator);
+        index64* index = entry.first;
+        if (index->code != current_receiver()) {
+            fail("db access violation");
+        }
+        auto& value = index->by_primary.at(entry.second);
+        index->entries.erase(std::make_pair(value.first, entry.second));
+        index->entries.insert(std::make_pair(secondary, entry.second));
+        value.first = secondary;
+        if (payer != 0) {
+            value.second = payer;
+        }
+    }
+
+    void chain::db_idx64_remove(int32_t iterator) {
+        count(IDX64_REMOVE);
+        const auto& entry = _index_iterators.get(iterator);
+        index64* index = entry.first;
+        if (index->code != current_receiver()) {
+            fail("db access violation");
+        }
+        auto value = index->by_primary.at(entry.second);
+        index->entries.erase(std::make_pair(value.first, entry.second));
+        index->by_primary.erase(entry.second);
+        _index_iterators.remove(iterator);
+    }
+
+    int32_t chain::db_idx64_next(int32_t iterator, uint64_t* primary) {
+        count(IDX64_NEXT);
+        if (iterator < -1) {
+            return -1;
+        }
+        const auto entry = _index_iterators.get(iterator);
+        index64* index = entry.first;
+        uint64_t secondary = index->by_primary.at(entry.second).first;
+        auto itr = index->entries.upper_bound(std::make_pair(secondary, entry.second));
+        if (itr != index->entries.end()) {
+            *primary = itr->second;
+        }
+        return index_iterator(index, itr);
+    }
+
+    int32_t chain::db_idx64_previous(int32_t iterator, uint64_t* primary) {
+        count(IDX64_PREVIOUS);
+        index64* index = nullptr;
+        std::set<std::pair<uint64_t, uint64_t>>::const_iterator itr;
+        if (iterator < -1) {
+            index = _index_iterators.table_of_end(iterator);
+            itr = index->entries.end();
+        } else {
+            const auto entry = _index_iterators.get(iterator);
+            index = entry.first;
+            uint64_t secondary = index->by_primary.at(entry.second).first;
+            itr = index->entries.lower_bound(std::make_pair(secondary, entry.second));
+        }
+        if (itr == index->entries.begin()) {
+            return -1;
+        }
+        itr--;
+        *primary = itr->second;
+        return _index_iterators.add(index, itr->second);
+    }
+
+    int32_t chain::db_idx64_find_primary(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t* secondary,
+                                         uint64_t primary) {
+        count(IDX64_FIND_PRIMARY);
+        index64* index = find_index(code, scope, table_name);
+        if (index == nullptr) {
+            return -1;
+        }
+        auto itr = index->by_primary.find(primary);
+        if (itr == index->by_primary.end()) {
+            return _index_iterators.end_of(index);
+        }
+        *secondary = itr->second.first;
+        return _index_iterators.add(index, primary);
+    }
+
+    int32_t chain::db_idx64_find_secondary(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t secondary,
+                                           uint64_t* primary) {
+        count(IDX64_FIND_SECONDARY);
+        index64* index = find_index(code, scope, table_name);
+        if (index == nullptr) {
+            return -1;
+        }
+        auto itr = index->entries.lower_bound(std::make_pair(secondary, (uint64_t) 0));
+        if (itr == index->entries.end() || itr->first != secondary) {
+            return _index_iterators.end_of(index);
+        }
+        *primary = itr->second;
+        return _index_iterators.add(index, itr->second);
+    }
+
+    int32_t chain::db_idx64_lowerbound(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t* secondary,
+                                       uint64_t* primary) {
+        count(IDX64_LOWERBOUND);
+        index64* index = find_index(code, scope, table_name);
+        if (index == nullptr) {
+            return -1;
+        }
+        auto itr = index->entries.lower_bound(std::make_pair(*secondary, (uint64_t) 0));
+        if (itr != index->entries.end()) {
+            *secondary = itr->first;
+            *primary = itr->second;
+        }
+        return index_iterator(index, itr);
+    }
+
+    int32_t chain::db_idx64_upperbound(uint64_t code, uint64_t scope, uint64_t table_name, uint64_t* secondary,
+                                       uint64_t* primary) {
+        count(IDX64_UPPERBOUND);
+        index64* index = find_index(code, scope, table_name);
+        if (index == nullptr) {
+            return -1;
+        }
+        auto itr = index->entries.upper_bound(std::make_pair(*secondary, std::numeric_limits<uint64_t>::max()));
+        if (itr != index->entries.end()) {
+            *secondary = itr->first;
+            *primary = itr->second;
+        }
+        return index_iterator(index, itr);
+    }
+
+    int32_t chain::db_idx64_end(uint64_t code, uint64_t scope, uint64_t table_name) {
+        count(IDX64_END);
+        index64* index = find_index(code, scope, table_name);
+        return index == nullptr ? -1 : _index_iterators.end_of(index);
+    }
+}
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * In-process stand-in for the parts of nodeos the game contracts talk to. The contracts are built as native shared
+ * modules and their apply() entry points are driven from here, with the eosiolib intrinsics (see intrinsics.cpp)
+ * routed to this class instead of a running chain.
+ */
+namespace godapp {
+namespace native {
+    typedef unsigned __int128 uint128_t;
+    typedef void (*apply_function)(uint64_t receiver, uint64_t code, uint64_t action);
+
+    /**
+     * Raised by eosio_assert and friends, aborts the transaction being executed
+     */
+    class assert_failure : public std::runtime_error {
+    public:
+        explicit assert_failure(const std::string& msg): std::runtime_error(msg) {}
+    };
+
+    /**
+     * Raised by eosio_exit, ends the current action successfully
+     */
+    struct exit_request {};
+
+    struct permission_level {
+        uint64_t actor;
+        uint64_t permission;
+    };
+
+    struct action_data {
+        uint64_t account;
+        uint64_t name;
+        std::vector<permission_level> authorization;
+        std::vector<char> data;
+    };
+
+    struct deferred_transaction {
+        uint64_t sender;
+        uint128_t sender_id;
+        uint64_t payer;
+        uint64_t execute_at;
+        std::vector<action_data> actions;
+    };
+
+    enum db_call {
+        DB_STORE, DB_UPDATE, DB_REMOVE, DB_GET, DB_NEXT, DB_PREVIOUS, DB_FIND, DB_LOWERBOUND, DB_UPPERBOUND, DB_END,
+        IDX64_STORE, IDX64_UPDATE, IDX64_REMOVE, IDX64_NEXT, IDX64_PREVIOUS, IDX64_FIND_PRIMARY,
+        IDX64_FIND_SECONDARY, IDX64_LOWERBOUND, IDX64_UPPERBOUND, IDX64_END,
+        DB_CALL_COUNT
+    };
+
+    const char* db_call_name(db_call call);
+
+    /**
+     * Cost counters for one contract action (receiver, action), accumulated over every time it was applied
+     */
+    struct action_stats {
+        uint64_t calls = 0;
+        uint64_t wall_ns = 0;
+        uint64_t db_calls[DB_CALL_COUNT] = {};
+        uint64_t bytes_written = 0;     // rows stored or updated
+        uint64_t unchanged_updates = 0; // db_update_i64 calls that stored the bytes already there
+        uint64_t bytes_read = 0;        // rows read back
+        uint64_t bytes_sent = 0;        // inline actions and deferred transactions
+        size_t heap_peak = 0;           // largest live contract heap seen in a single apply
+
+        uint64_t total_db_calls() const;
+    };
+
+    /**
+     * Live heap allocated by contract code, the intrinsics switch tracking off while the emulator itself runs
+     */
+    struct heap_usage {
+        bool tracking;
+        size_t current;
+        size_t peak;
+        size_t allocations;
+    };
+    extern thread_local heap_usage contract_heap;
+
+    uint64_t string_to_name(const char* str);
+    std::string name_to_string(uint64_t value);
+
+    std::vector<char> pack_action(const action_data& act);
+    action_data unpack_action(const char* data, size_t size, size_t* consumed = nullptr);
+
+    class chain {
+    public:
+        static chain& instance();
+
+        // ---- accounts and code
+        void create_account(uint64_t account);
+        bool is_account(uint64_t account) const;
+        void set_code(uint64_t account, apply_function apply);
+        void load_contract(uint64_t account, const std::string& module_path);
+
+        // ---- eosio.token emulation
+        void issue(uint64_t account, int64_t amount, uint64_t symbol);
+        int64_t get_balance(uint64_t account, uint64_t symbol) const;
+
+        // ---- block production
+        uint64_t current_time() const { return _now; }
+        uint32_t block_num() const { return _block_num; }
+        uint32_t block_prefix() const { return _block_prefix; }
+        void produce_block(uint32_t seconds = 0);
+
+        /**
+         * Execute a list of actions as one transaction, all changes are rolled back if any action fails
+         */
+        void push_transaction(const std::vector<action_data>& actions);
+        void push_action(const action_data& act) { push_transaction({act}); }
+
+        /**
+         * Execute all deferred transactions that are due, including ones scheduled while running them
+         * @return Number of deferred transactions executed
+         */
+        size_t run_deferred();
+        size_t pending_deferred() const { return _deferred.size(); }
+        const std::vector<std::string>& failed_deferred() const { return _failed_deferred; }
+
+        /**
+         * Raw bytes of a table row, for drivers inspecting contract state
+         * @return Whether the row exists
+         */
+        bool get_row(uint64_t code, uint64_t scope, uint64_t table, uint64_t id, std::vector<char>& value) const;
+
+        const std::map<std::pair<uint64_t, uint64_t>, action_stats>& stats() const { return _stats; }
+        void reset_stats() { _stats.clear(); }
+
+        const std::string& console() const { return _console; }
+        void clear_console() { _console.clear(); }
+
+        // ---- action context, used by the intrinsics
+        const action_data& current_action() const;
+        uint64_t current_receiver() const;
+        void require_auth(uint64_t account, uint64_t permission = 0) const;
+        bool has_auth(uint64_t account) const;
+        void require_recipient(uint64_t account);
+        void send_inline(const char* data, size_t size);
+        void send_deferred(uint128_t sender_id, uint64_t payer, const char* data, size_t size, bool replace);
+        bool cancel_deferred(uint128_t sender_id);
+        int get_action(uint32_t type, uint32_t index, char* buffer, size_t size) const;
+        void print(const std::string& str) { _console += str; }
+
+        // ---- database, used by the intrinsics
+        int32_t db_store_i64(uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, const void* data, uint32_t len);
+        void db_update_i64(int32_t iterator, uint64_t payer, const void* data, uint32_t len);
+        void db_remove_i64(int32_t iterator);
+        int32_t db_get_i64(int32_t iterator, void* data, uint32_t len);
+        int32_t db_next_i64(int32_t iterator, uint64_t* primary);
+        int32_t db_previous_i64(int32_t iterator, uint64_t* primary);
+        int32_t db_find_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id);
+        int32_t db_lowerbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id);
+        int32_t db_upperbound_i64(uint64_t code, uint64_t scope, uint64_t table, uint64_t id);
+        int32_t db_end_i64(uint64_t code, uint64_t scope, uint64_t table);
+
+        int32_t db_idx64_store(uint64_t scope, uint64_t table, uint64_t payer, uint64_t id, uint64_t secondary);
+        void db_idx64_update(int32_t iterator, uint64_t payer, uint64_t secondary);
+        void db_idx64_remove(int32_t iterator);
+        int32_t db_idx64_next(int32_t iterator, uint64_t* primary);
+        int32_t db_idx64_previous(int32_t iterator, uint64_t* primary);
+        int32_t db_idx64_find_primary(uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary,
+                                      uint64_t primary);
+        int32_t db_idx64_find_secondary(uint64_t code, uint64_t scope, uint64_t table, uint64_t secondary,
+                                        uint64_t* primary);
+        int32_t db_idx64_lowerbound(uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary,
+                                    uint64_t* primary);
+        int32_t db_idx64_upperbound(uint64_t code, uint64_t scope, uint64_t table, uint64_t* secondary,
+                                    uint64_t* primary);
+        int32_t db_idx64_end(uint64_t code, uint64_t scope, uint64_t table);
+
+    private:
+        struct table_key {
+            uint64_t code;
+            uint64_t scope;
+            uint64_t table;
+
+            bool operator<(const table_key& other) const {
+                if (code != other.code) return code < other.code;
+                if (scope != other.scope) return scope < other.scope;
+                return table < other.table;
+            }
+        };
+
+        struct row {
+            uint64_t payer;
+            std::vector<char> value;
+        };
+
+        struct table {
+            uint64_t code;
+            std::map<uint64_t, row> rows;
+        };
+
+        struct index64 {
+            uint64_t code;
+            // (secondary, primary) in iteration order, plus the reverse lookup
+            std::set<std::pair<uint64_t, uint64_t>> entries;
+            std::map<uint64_t, std::pair<uint64_t, uint64_t>> by_primary; // primary => (secondary, payer)
+        };
+
+        /**
+         * Maps the integer iterators handed to the contract to rows, mirroring nodeos' iterator_cache: end
+         * iterators are -(table index + 2), -1 means "no such table"
+         */
+        template<typename Table>
+        struct iterator_cache {
+            std::vector<Table*> end_tables;
+            std::map<Table*, int32_t> table_ends;
+            std::vector<std::pair<Table*, uint64_t>> iterators;
+            std::map<std::pair<Table*, uint64_t>, int32_t> lookup;
+
+            int32_t end_of(Table* t);
+            Table* table_of_end(int32_t iterator) const;
+            int32_t add(Table* t, uint64_t primary);
+            const std::pair<Table*, uint64_t>& get(int32_t iterator) const;
+            void remove(int32_t iterator);
+            void clear();
+        };
+
+        struct apply_context {
+            const action_data* act;
+            uint64_t receiver;
+            std::vector<uint64_t>* notified;
+            std::vector<action_data>* inline_actions;
+        };
+
+        struct state {
+            std::map<table_key, table> tables;
+            std::map<table_key, index64> indexes;
+            std::map<std::pair<uint64_t, uint64_t>, int64_t> balances;
+            std::deque<deferred_transaction> deferred;
+        };
+
+        chain();
+
+        void execute_action(const action_data& act, uint32_t depth);
+        void apply(const action_data& act, uint64_t receiver);
+        void apply_token(const action_data& act, uint64_t receiver);
+        state snapshot() const;
+        void restore(state&& saved);
+
+        table* find_table(uint64_t code, uint64_t scope, uint64_t table);
+        index64* find_index(uint64_t code, uint64_t scope, uint64_t table);
+        void count(db_call call) { if (_current_stats) _current_stats->db_calls[call]++; }
+        int32_t index_iterator(index64* index, std::set<std::pair<uint64_t, uint64_t>>::const_iterator itr);
+
+        std::set<uint64_t> _accounts;
+        std::map<uint64_t, apply_function> _code;
+        std::map<table_key, table> _tables;
+        std::map<table_key, index64> _indexes;
+        std::map<std::pair<uint64_t, uint64_t>, int64_t> _balances;
+        std::deque<deferred_transaction> _deferred;
+        std::vector<std::string> _failed_deferred;
+
+        std::vector<action_data> _transaction;
+        apply_context* _context = nullptr;
+        iterator_cache<table> _table_iterators;
+        iterator_cache<index64> _index_iterators;
+
+        std::map<std::pair<uint64_t, uint64_t>, action_stats> _stats;
+        action_stats* _current_stats = nullptr;
+
+        uint64_t _now;
+        uint32_t _block_num;
+        uint32_t _block_prefix;
+        std::string _console;
+    };
+}
+}
@@ -0,0 +1,13 @@
+// baccarat and cbaccarat deal from an 8 deck shoe, which needs uint16_t
+#define card_t uint16_t
+
+#include "card_deck_check.hpp"
+
+/**
+ * Every stream deals 52 cards of the shoe and every 20th one the whole shoe
+ *
+ * usage: native_check_card_deck_416
+ */
+int main() {
+    return godapp::native::check_card_deck(52 * 8, 20) ? 0 : 1;
+}
@@ -0,0 +1,13 @@
+// redblack, blackjack and bullfight deal their 52 cards as uint8_t
+#define card_t uint8_t
+
+#include "card_deck_check.hpp"
+
+/**
+ * Every stream deals the whole deck
+ *
+ * usage: native_check_card_deck_52
+ */
+int main() {
+    return godapp::native::check_card_deck(52, 1) ? 0 : 1;
+}
@@ -0,0 +1,182 @@
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+
+#include "../roulette/roulette.cpp"
+
+/**
+ * Check the history page codec and ring that frontends read: the bytes of a known entry, then many settlements of
+ * varying size appended through history_writer and read back with read_history_page. Every round game declares the
+ * same entry with DEFINE_HISTORY_TABLE, roulette's is used.
+ *
+ * usage: native_check_history
+ */
+using namespace godapp;
+
+#define CHECK_KEEP          40
+#define CHECK_SETTLEMENTS   200
+
+typedef roulette::history entry;
+typedef roulette::histpage page;
+
+/**
+ * The calls history_writer makes on a multi_index, kept in memory so the rows written by each flush are counted
+ */
+class page_table {
+public:
+    typedef const page* const_iterator;
+
+    page_table(name self, uint64_t scope) {
+    }
+
+    static std::map<uint64_t, page>& rows() {
+        static std::map<uint64_t, page> stored;
+        return stored;
+    }
+
+    static uint32_t& writes() {
+        static uint32_t count = 0;
+        return count;
+    }
+
+    const_iterator find(uint64_t id) const {
+        auto iter = rows().find(id);
+        return iter == rows().end() ? end() : &iter->second;
+    }
+
+    const_iterator end() const {
+        return nullptr;
+    }
+
+    template<typename Lambda>
+    void emplace(name payer, Lambda&& constructor) {
+        page row;
+        constructor(row);
+        eosio_assert(rows().count(row.id) == 0, "page emplaced twice");
+        rows()[row.id] = row;
+        writes()++;
+    }
+
+    template<typename Lambda>
+    void modify(const_iterator iter, name payer, Lambda&& updater) {
+        page row = *iter;
+        updater(row);
+        eosio_assert(row.id == iter->id, "page id changed");
+        rows()[row.id] = row;
+        writes()++;
+    }
+};
+
+typedef history_writer<page_table, page> history_log;
+
+/**
+ * Fields of the entry with sequence number seq, the amounts spread over the range an asset allows, negative included
+ */
+static entry make_entry(uint64_t seq) {
+    uint64_t mixed = seq * 0x9E3779B97F4A7C15ull;
+    return entry{name(0x5530ea0000000000ull + seq), asset((int64_t) (mixed >> 2) - (1ll << 61), EOS_SYMBOL),
+                 (uint8_t) seq, asset((int64_t) (mixed >> (seq % 62 + 2)), EOS_SYMBOL), mixed >> 32, seq * 37};
+}
+
+static bool same_entry(const entry& left, const entry& right) {
+    return left.player == right.player && left.bet == right.bet && left.bet_type == right.bet_type
+           && left.payout == right.payout && left.close_time == right.close_time && left.result == right.result;
+}
+
+static bool check_layout() {
+    static const uint8_t EXPECTED[] = {
+        0x80, 0x80, 0x80, 0x80, 0xc2, 0xab, 0xf9, 0xa6, 0xac, 0x01,     // player1
+        0xa0, 0x9c, 0x01, 0x84, 0x8a, 0xbd, 0x9a, 0x05,                 // 1.0000 EOS, zigzag amount and symbol
+        0x03,                                                           // bet type
+        0xa0, 0xb2, 0x02, 0x84, 0x8a, 0xbd, 0x9a, 0x05,                 // 1.9600 EOS
+        0x80, 0xdb, 0xaa, 0xe1, 0x05,                                   // close time
+        0x11                                                            // result
+    };
+    entry known{name("player1"), asset(10000, EOS_SYMBOL), 3, asset(19600, EOS_SYMBOL), 1546300800, 17};
+    vector<char> data;
+    history_encoder encoder(data);
+    known.history_fields(encoder);
+    if (data.size() != sizeof(EXPECTED) || memcmp(data.data(), EXPECTED, sizeof(EXPECTED)) != 0) {
+        printf("history: entry encoded as %zu bytes, expected %zu:", data.size(), sizeof(EXPECTED));
+        for (char byte : data) {
+            printf(" %02x", (uint8_t) byte);
+        }
+        printf("\n");
+        return false;
+    }
+
+    entry decoded;
+    history_decoder decoder(data);
+    decoded.history_fields(decoder);
+    if (!same_entry(known, decoded)) {
+        printf("history: the known entry does not decode to itself\n");
+        return false;
+    }
+    return true;
+}
+
+static bool check_ring() {
+    uint64_t pages = CHECK_KEEP / HISTORY_PAGE_SIZE + 1;
+    uint64_t head = 0;
+    for (uint32_t settlement = 0; settlement < CHECK_SETTLEMENTS; settlement++) {
+        // settlements of 1 to 45 entries, so some span three pages and later ones wrap the ring many times
+        uint64_t count = settlement * 7 % 45 + 1;
+        history_log history(name("roulette"), head, CHECK_KEEP);
+        page_table::writes() = 0;
+        for (uint64_t i = 0; i < count; i++) {
+            history.append(make_entry(head + i + 1));
+        }
+        history.flush();
+        if (history.last_seq() != head + count) {
+            printf("history: head %llu after %llu entries from %llu\n", (unsigned long long) history.last_seq(),
+                   (unsigned long long) count, (unsigned long long) head);
+            return false;
+        }
+
+        // one write per page the settlement moved through, a settlement longer than the ring writes a page again
+        uint64_t touched = (head + count) / HISTORY_PAGE_SIZE - (head + 1) / HISTORY_PAGE_SIZE + 1;
+        if (page_table::writes() != touched) {
+            printf("history: %u page writes for entries %llu to %llu, expected %llu\n", page_table::writes(),
+                   (unsigned long long) head + 1, (unsigned long long) head + count, (unsigned long long) touched);
+            return false;
+        }
+        head = history.last_seq();
+
+        std::map<uint64_t, entry> read;
+        for (const auto& row : page_table::rows()) {
+            read_history_page<entry>(row.second, [&](uint64_t seq, const entry& item) {
+                read[seq] = item;
+            });
+        }
+        if (page_table::rows().size() > pages) {
+            printf("history: %zu pages for a ring of %llu\n", page_table::rows().size(), (unsigned long long) pages);
+            return false;
+        }
+        for (uint64_t seq = head > CHECK_KEEP ? head - CHECK_KEEP + 1 : 1; seq <= head; seq++) {
+            if (read.count(seq) == 0) {
+                printf("history: entry %llu missing at head %llu\n", (unsigned long long) seq,
+                       (unsigned long long) head);
+                return false;
+            }
+        }
+        for (const auto& item : read) {
+            if (item.first > head || !same_entry(item.second, make_entry(item.first))) {
+                printf("history: entry %llu read back wrong at head %llu\n", (unsigned long long) item.first,
+                       (unsigned long long) head);
+                return false;
+            }
+        }
+    }
+    printf("history: layout ok, %u settlements up to entry %llu read back from %zu pages\n", CHECK_SETTLEMENTS,
+           (unsigned long long) head, page_table::rows().size());
+    return true;
+}
+
+int main() {
+    try {
+        return check_layout() && check_ring() ? 0 : 1;
+    } catch (const std::exception& e) {
+        printf("history: %s\n", e.what());
+        return 1;
+    }
+}
@@ -0,0 +1,29 @@
+#include "../quick3/quick3.cpp"
+#include "risk_check.hpp"
+
+/**
+ * Check quick3_result::worst_payout against every roll of the three dice, the bound may be above the worst roll
+ *
+ * usage: native_check_risk_quick3
+ */
+using namespace godapp;
+
+int main() {
+    // a roll is drawn as one number below 216 and split into dice the way quick3_result does
+    auto outcome_payout = [](uint32_t outcome, uint8_t bet_type, int64_t stake) {
+        uint8_t dices[3];
+        uint8_t sum = 0;
+        for (int i = 0; i < 3; i++) {
+            dices[i] = outcome % 6 + 1;
+            sum += dices[i];
+            outcome /= 6;
+        }
+        std::sort(dices, dices + 3);
+        bool pair = dices[0] == dices[1] || dices[1] == dices[2];
+        bool three_of_a_kind = dices[0] == dices[2];
+        bool straight = dices[1] == dices[0] + 1 && dices[2] == dices[1] + 1;
+        quick3::bet bet_item{asset(stake, EOS_SYMBOL), bet_type};
+        return quick3_result::payout(sum, pair, straight, three_of_a_kind, bet_item).amount;
+    };
+    return native::check_worst_payout<quick3_result>("quick3", 216, outcome_payout, false) ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+#include "../roulette/roulette.cpp"
+#include "risk_check.hpp"
+
+/**
+ * Check roulette_result::worst_payout against every number of the wheel, the bound must be exact
+ *
+ * usage: native_check_risk_roulette
+ */
+using namespace godapp;
+
+int main() {
+    auto outcome_payout = [](uint32_t outcome, uint8_t bet_type, int64_t stake) {
+        roulette::bet bet_item{asset(stake, EOS_SYMBOL), bet_type};
+        return roulette_result::payout((uint8_t) outcome, bet_item).amount;
+    };
+    return native::check_worst_payout<roulette_result>("roulette", BET_NUMBER_END, outcome_payout, true) ? 0 : 1;
+}
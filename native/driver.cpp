@@ -0,0 +1,70 @@
+#include <cstdio>
+#include <cstring>
+
+#include "tester.hpp"
+
+/**
+ * Smoke run of a full dice round on the emulator: register the game, bet, reveal and collect the payout
+ * usage: native_driver [contract module dir]
+ */
+using namespace godapp::native;
+
+#define DICE_ACCOUNT name("dicegameacct")
+#define PLAYER_ACCOUNT name("playeraccnt1")
+#define DICE_ID 1
+#define ROUNDS 10
+
+static void print_balances(tester& t) {
+    printf("house  %s\n", t.get_balance(HOUSE_ACCOUNT).to_string().c_str());
+    printf("dice   %s\n", t.get_balance(DICE_ACCOUNT).to_string().c_str());
+    printf("player %s\n", t.get_balance(PLAYER_ACCOUNT).to_string().c_str());
+}
+
+int main(int argc, char** argv) {
+    tester t(argc > 1 ? argv[1] : NATIVE_CONTRACT_DIR);
+
+    try {
+        t.deploy(HOUSE_ACCOUNT, "house");
+        t.deploy(DICE_ACCOUNT, "dice");
+        t.create_account(PLAYER_ACCOUNT);
+        t.issue(HOUSE_ACCOUNT, asset(10000000, EOS_SYMBOL));
+        t.issue(PLAYER_ACCOUNT, asset(1000000, EOS_SYMBOL));
+
+        // addgame schedules the deferred init of the game
+        t.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("addgame"), DICE_ACCOUNT, (uint64_t) DICE_ID);
+        t.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("updatetoken"), DICE_ACCOUNT, EOS_SYMBOL, EOS_TOKEN_CONTRACT,
+               (uint64_t) 1000, (uint64_t) 2000000, (uint64_t) 5000000);
+        capi_public_key key;
+        memset(&key, 0, sizeof(key));
+        t.push(HOUSE_ACCOUNT, HOUSE_ACCOUNT, name("setrandkey"), key);
+        t.produce_block();
+
+        print_balances(t);
+        for (uint64_t bet_id = 1; bet_id <= ROUNDS; bet_id++) {
+            t.transfer(PLAYER_ACCOUNT, DICE_ACCOUNT, asset(10000, EOS_SYMBOL), "50,,");
+
+            capi_signature sig;
+            for (size_t i = 0; i < sizeof(sig.data); i++) {
+                sig.data[i] = (uint8_t) (i * 7 + bet_id);
+            }
+            t.push(HOUSE_ACCOUNT, DICE_ACCOUNT, name("reveal"), bet_id, sig);
+
+            // reveal => dice::pay => house::pay => eosio.token transfer
+            while (t.produce_block() > 0) {
+            }
+        }
+        print_balances(t);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+
+    const chain& c = t.get_chain();
+    for (const auto& failure : c.failed_deferred()) {
+        fprintf(stderr, "deferred transaction failed: %s\n", failure.c_str());
+    }
+    if (!c.console().empty()) {
+        printf("console: %s\n", c.console().c_str());
+    }
+    return c.failed_deferred().empty() ? 0 : 1;
+}
@@ -0,0 +1,400 @@
+#include "chain.hpp"
+#include "sha256.hpp"
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+/**
+ * Host implementations of the eosiolib intrinsics used by the contracts, with the same C signatures as the
+ * eosio.cdt headers. Everything forwards to godapp::native::chain.
+ */
+using godapp::native::assert_failure;
+using godapp::native::chain;
+using godapp::native::exit_request;
+using godapp::native::uint128_t;
+
+typedef uint64_t capi_name;
+
+struct __attribute__((aligned(16))) capi_checksum256 {
+    uint8_t hash[32];
+};
+
+namespace godapp {
+namespace native {
+    thread_local heap_usage contract_heap = {false, 0, 0, 0};
+}
+}
+
+using godapp::native::contract_heap;
+
+#define HEAP_BLOCK_HEADER 16
+
+/**
+ * Contracts rely on wasm linear memory starting out zeroed, e.g. table rows whose fields are not all assigned in the
+ * emplace lambda. Hand out zeroed memory so the native build sees the same values. Every block records how many
+ * bytes were charged to the contract heap so the high-water mark can be reported per action.
+ */
+void* operator new(size_t size) {
+    char* block = static_cast<char*>(calloc(1, size + HEAP_BLOCK_HEADER));
+    if (block == nullptr) {
+        throw std::bad_alloc();
+    }
+    size_t charged = 0;
+    if (contract_heap.tracking) {
+        charged = size;
+        contract_heap.allocations++;
+    }
+    *reinterpret_cast<size_t*>(block) = charged;
+    contract_heap.current += charged;
+    contract_heap.peak = std::max(contract_heap.peak, contract_heap.current);
+    return block + HEAP_BLOCK_HEADER;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    char* block = static_cast<char*>(ptr) - HEAP_BLOCK_HEADER;
+    contract_heap.current -= *reinterpret_cast<size_t*>(block);
+    free(block);
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+/**
+ * Allocations made by the emulator on behalf of an intrinsic are not charged to the contract
+ */
+struct host_call {
+    bool tracking;
+
+    host_call(): tracking(contract_heap.tracking) {
+        contract_heap.tracking = false;
+    }
+
+    ~host_call() {
+        contract_heap.tracking = tracking;
+    }
+};
+
+extern "C" {
+    //###############    System  ######################
+    void eosio_assert(uint32_t test, const char* msg) {
+        host_call guard;
+        if (!test) {
+            throw assert_failure(std::string("assertion failure with message: ") + msg);
+        }
+    }
+
+    void eosio_assert_message(uint32_t test, const char* msg, uint32_t msg_len) {
+        host_call guard;
+        if (!test) {
+            throw assert_failure(std::string("assertion failure with message: ") + std::string(msg, msg_len));
+        }
+    }
+
+    void eosio_assert_code(uint32_t test, uint64_t code) {
+        host_call guard;
+        if (!test) {
+            throw assert_failure("assertion failure with error code: " + std::to_string(code));
+        }
+    }
+
+    void eosio_exit(int32_t code) {
+        host_call guard;
+        throw exit_request();
+    }
+
+    uint64_t current_time() {
+        host_call guard;
+        return chain::instance().current_time();
+    }
+
+    uint64_t publication_time() {
+        host_call guard;
+        return chain::instance().current_time();
+    }
+
+    //###############    Action  ######################
+    uint32_t read_action_data(void* msg, uint32_t len) {
+        host_call guard;
+        const auto& data = chain::instance().current_action().data;
+        uint32_t size = std::min(len, (uint32_t) data.size());
+        if (size > 0) {
+            memcpy(msg, data.data(), size);
+        }
+        return size;
+    }
+
+    uint32_t action_data_size() {
+        host_call guard;
+        return (uint32_t) chain::instance().current_action().data.size();
+    }
+
+    void require_recipient(capi_name name) {
+        host_call guard;
+        chain::instance().require_recipient(name);
+    }
+
+    void require_auth(capi_name name) {
+        host_call guard;
+        chain::instance().require_auth(name);
+    }
+
+    void require_auth2(capi_name name, capi_name permission) {
+        host_call guard;
+        chain::instance().require_auth(name, permission);
+    }
+
+    bool has_auth(capi_name name) {
+        host_call guard;
+        return chain::instance().has_auth(name);
+    }
+
+    bool is_account(capi_name name) {
+        host_call guard;
+        return chain::instance().is_account(name);
+    }
+
+    void send_inline(char* serialized_action, size_t size) {
+        host_call guard;
+        chain::instance().send_inline(serialized_action, size);
+    }
+
+    uint64_t current_receiver() {
+        host_call guard;
+        return chain::instance().current_receiver();
+    }
+
+    //###############    Transaction  ######################
+    void send_deferred(const uint128_t& sender_id, capi_name payer, const char* serialized_transaction, size_t size,
+                       uint32_t replace_existing) {
+        host_call guard;
+        chain::instance().send_deferred(sender_id, payer, serialized_transaction, size, replace_existing != 0);
+    }
+
+    int cancel_deferred(const uint128_t& sender_id) {
+        host_call guard;
+        return chain::instance().cancel_deferred(sender_id) ? 1 : 0;
+    }
+
+    int tapos_block_num() {
+        host_call guard;
+        return (int) (chain::instance().block_num() & 0xffff);
+    }
+
+    int tapos_block_prefix() {
+        host_call guard;
+        return (int) chain::instance().block_prefix();
+    }
+
+    uint32_t expiration() {
+        host_call guard;
+        return (uint32_t) (chain::instance().current_time() / 1000000) + 30;
+    }
+
+    int get_action(uint32_t type, uint32_t index, char* buff, size_t size) {
+        host_call guard;
+        return chain::instance().get_action(type, index, buff, size);
+    }
+
+    //###############    Crypto  ######################
+    void sha256(const char* data, uint32_t length, capi_checksum256* hash) {
+        host_call guard;
+        godapp::native::sha256(data, length, hash->hash);
+    }
+
+    void assert_sha256(const char* data, uint32_t length, const capi_checksum256* hash) {
+        host_call guard;
+        capi_checksum256 result;
+        godapp::native::sha256(data, length, result.hash);
+        if (memcmp(result.hash, hash->hash, sizeof(result.hash)) != 0) {
+            throw assert_failure("hash mismatch");
+        }
+    }
+
+    /**
+     * Signatures are not verified off-chain, the games only use the signature bytes as a source of randomness
+     */
+    void assert_recover_key(const capi_checksum256* digest, const char* sig, size_t siglen, const char* pub,
+                            size_t publen) {
+        host_call guard;
+        if (siglen == 0 || publen == 0) {
+            throw assert_failure("Error expected key different than recovered key");
+        }
+    }
+
+    //###############    Print  ######################
+    void prints(const char* cstr) {
+        host_call guard;
+        chain::instance().print(cstr);
+    }
+
+    void prints_l(const char* cstr, uint32_t len) {
+        host_call guard;
+        chain::instance().print(std::string(cstr, len));
+    }
+
+    void printi(int64_t value) {
+        host_call guard;
+        chain::instance().print(std::to_string(value));
+    }
+
+    void printui(uint64_t value) {
+        host_call guard;
+        chain::instance().print(std::to_string(value));
+    }
+
+    void printsf(float value) {
+        host_call guard;
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.6e", value);
+        chain::instance().print(buffer);
+    }
+
+    void printdf(double value) {
+        host_call guard;
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.15e", value);
+        chain::instance().print(buffer);
+    }
+
+    void printn(uint64_t name) {
+        host_call guard;
+        chain::instance().print(godapp::native::name_to_string(name));
+    }
+
+    void printhex(const void* data, uint32_t datalen) {
+        host_call guard;
+        static const char* digits = "0123456789abcdef";
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        std::string str;
+        for (uint32_t i = 0; i < datalen; i++) {
+            str += digits[bytes[i] >> 4];
+            str += digits[bytes[i] & 0x0f];
+        }
+        chain::instance().print(str);
+    }
+
+    //###############    Database  ######################
+    int32_t db_store_i64(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const void* data,
+                         uint32_t len) {
+        host_call guard;
+        return chain::instance().db_store_i64(scope, table, payer, id, data, len);
+    }
+
+    void db_update_i64(int32_t iterator, capi_name payer, const void* data, uint32_t len) {
+        host_call guard;
+        chain::instance().db_update_i64(iterator, payer, data, len);
+    }
+
+    void db_remove_i64(int32_t iterator) {
+        host_call guard;
+        chain::instance().db_remove_i64(iterator);
+    }
+
+    int32_t db_get_i64(int32_t iterator, const void* data, uint32_t len) {
+        host_call guard;
+        return chain::instance().db_get_i64(iterator, const_cast<void*>(data), len);
+    }
+
+    int32_t db_next_i64(int32_t iterator, uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_next_i64(iterator, primary);
+    }
+
+    int32_t db_previous_i64(int32_t iterator, uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_previous_i64(iterator, primary);
+    }
+
+    int32_t db_find_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+        host_call guard;
+        return chain::instance().db_find_i64(code, scope, table, id);
+    }
+
+    int32_t db_lowerbound_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+        host_call guard;
+        return chain::instance().db_lowerbound_i64(code, scope, table, id);
+    }
+
+    int32_t db_upperbound_i64(capi_name code, uint64_t scope, capi_name table, uint64_t id) {
+        host_call guard;
+        return chain::instance().db_upperbound_i64(code, scope, table, id);
+    }
+
+    int32_t db_end_i64(capi_name code, uint64_t scope, capi_name table) {
+        host_call guard;
+        return chain::instance().db_end_i64(code, scope, table);
+    }
+
+    int32_t db_idx64_store(uint64_t scope, capi_name table, capi_name payer, uint64_t id, const uint64_t* secondary) {
+        host_call guard;
+        return chain::instance().db_idx64_store(scope, table, payer, id, *secondary);
+    }
+
+    void db_idx64_update(int32_t iterator, capi_name payer, const uint64_t* secondary) {
+        host_call guard;
+        chain::instance().db_idx64_update(iterator, payer, *secondary);
+    }
+
+    void db_idx64_remove(int32_t iterator) {
+        host_call guard;
+        chain::instance().db_idx64_remove(iterator);
+    }
+
+    int32_t db_idx64_next(int32_t iterator, uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_idx64_next(iterator, primary);
+    }
+
+    int32_t db_idx64_previous(int32_t iterator, uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_idx64_previous(iterator, primary);
+    }
+
+    int32_t db_idx64_find_primary(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary,
+                                  uint64_t primary) {
+        host_call guard;
+        return chain::instance().db_idx64_find_primary(code, scope, table, secondary, primary);
+    }
+
+    int32_t db_idx64_find_secondary(capi_name code, uint64_t scope, capi_name table, const uint64_t* secondary,
+                                    uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_idx64_find_secondary(code, scope, table, *secondary, primary);
+    }
+
+    int32_t db_idx64_lowerbound(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary,
+                                uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_idx64_lowerbound(code, scope, table, secondary, primary);
+    }
+
+    int32_t db_idx64_upperbound(capi_name code, uint64_t scope, capi_name table, uint64_t* secondary,
+                                uint64_t* primary) {
+        host_call guard;
+        return chain::instance().db_idx64_upperbound(code, scope, table, secondary, primary);
+    }
+
+    int32_t db_idx64_end(capi_name code, uint64_t scope, capi_name table) {
+        host_call guard;
+        return chain::instance().db_idx64_end(code, scope, table);
+    }
+}
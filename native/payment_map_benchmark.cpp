@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <vector>
+
+#include "chain.hpp"
+#include "../common/payment_map.hpp"
+
+/**
+ * Micro benchmark of the per-player payment aggregation done when settling a round: the std::map the games used to
+ * build against godapp::payment_map. Heap usage is measured with the emulator's contract heap counters.
+ *
+ * usage: native_payment_map_benchmark [iterations]
+ */
+using namespace godapp;
+using godapp::native::contract_heap;
+
+struct bet_row {
+    name player;
+    asset bet;
+    asset payout;
+};
+
+struct measurement {
+    double avg_us;
+    size_t allocations;
+    size_t heap_peak;
+};
+
+static std::vector<bet_row> make_bets(size_t bets, size_t players) {
+    std::vector<bet_row> rows;
+    uint64_t seed = 0x2545F4914F6CDD1Dull;
+    for (size_t i = 0; i < bets; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        // spread the players over realistic looking name values
+        uint64_t player = 0x5530ea0000000000ull + (seed % players) * 0x1000000ull;
+        rows.push_back(bet_row{name(player), asset(1000, EOS_SYMBOL), asset((int64_t) (seed % 3) * 1000, EOS_SYMBOL)});
+    }
+    return rows;
+}
+
+template<typename Aggregate>
+static measurement measure(uint32_t iterations, Aggregate&& aggregate) {
+    contract_heap.current = 0;
+    contract_heap.peak = 0;
+    contract_heap.allocations = 0;
+
+    int64_t checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < iterations; i++) {
+        contract_heap.tracking = true;
+        checksum += aggregate();
+        contract_heap.tracking = false;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    if (checksum == 42) {
+        printf(" ");
+    }
+
+    double total_us = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 1000.0;
+    return measurement{total_us / iterations, contract_heap.allocations / iterations, contract_heap.peak};
+}
+
+int main(int argc, char** argv) {
+    uint32_t iterations = argc > 1 ? (uint32_t) atoi(argv[1]) : 200;
+
+    printf("%7s %7s | %10s %8s %10s | %10s %8s %10s\n", "bets", "players", "map us", "allocs", "peak",
+           "flat us", "allocs", "peak");
+    for (size_t bets : {50, 200, 1000, 5000}) {
+        for (size_t players : {bets / 10, bets / 2, bets}) {
+            std::vector<bet_row> rows = make_bets(bets, players);
+
+            measurement tree = measure(iterations, [&]() {
+                struct pay_result {
+                    asset bet;
+                    asset payout;
+                    name referer;
+                };
+                std::map<uint64_t, pay_result> result_map;
+                for (const auto& row : rows) {
+                    auto result_itr = result_map.find(row.player.value);
+                    if (result_itr == result_map.end()) {
+                        result_map[row.player.value] = pay_result{row.bet, row.payout, name()};
+                    } else {
+                        result_itr->second.bet += row.bet;
+                        result_itr->second.payout += row.payout;
+                    }
+                }
+                int64_t total = 0;
+                for (const auto& item : result_map) {
+                    total += item.second.payout.amount;
+                }
+                return total;
+            });
+
+            measurement flat = measure(iterations, [&]() {
+                payment_map result_map(rows.size());
+                for (const auto& row : rows) {
+                    result_map.add_payment(row.player, row.bet, row.payout, name());
+                }
+                int64_t total = 0;
+                for (const auto& item : result_map.sorted()) {
+                    total += item.result.payout.amount;
+                }
+                return total;
+            });
+
+            printf("%7zu %7zu | %10.2f %8zu %10zu | %10.2f %8zu %10zu\n", bets, players, tree.avg_us,
+                   tree.allocations, tree.heap_peak, flat.avg_us, flat.allocations, flat.heap_peak);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Brute force check of a round game's worst_payout, the bound place_bet accepts bets against. Included after the
+ * game's contract source so its result class is in scope.
+ */
+#define RISK_CHECK_UNIT             10000       // the single bets are 1.0000 EOS
+#define RISK_CHECK_STAKE_SETS       20000
+#define RISK_CHECK_MAX_BETS         12
+#define RISK_CHECK_MAX_STAKE        100000
+
+namespace godapp {
+namespace native {
+    /**
+     * Compare Result::worst_payout with the largest total payout over every outcome of the round, first for a
+     * single bet on each bet type, then for random stakes on random bet types.
+     * @param outcomes Number of outcomes of a round, the brute force tries [0, outcomes)
+     * @param outcome_payout outcome_payout(outcome, bet_type, stake) is what the contract pays a stake for an outcome
+     * @param exact Whether the bound must equal the brute force, otherwise it only must not fall below it
+     * @return Whether the bound held for every stake set
+     */
+    template<typename Result, typename OutcomePayout>
+    bool check_worst_payout(const char* game, uint32_t outcomes, OutcomePayout&& outcome_payout, bool exact) {
+        uint32_t stake_types = Result::BET_TYPES + 1;
+        uint32_t failed = 0, matched = 0;
+        auto check = [&](const std::vector<int64_t>& stakes) {
+            int64_t brute = 0;
+            for (uint32_t outcome = 0; outcome < outcomes; outcome++) {
+                int64_t total = 0;
+                for (uint8_t bet_type = 0; bet_type < stake_types; bet_type++) {
+                    if (stakes[bet_type] > 0) {
+                        total += outcome_payout(outcome, bet_type, stakes[bet_type]);
+                    }
+                }
+                brute = std::max(brute, total);
+            }
+
+            int64_t bound = Result::worst_payout(stakes);
+            if (bound < brute || (exact && bound != brute)) {
+                if (failed == 0) {
+                    printf("%s: worst_payout %lld, brute force %lld for stakes", game, (long long) bound,
+                           (long long) brute);
+                    for (uint8_t bet_type = 0; bet_type < stake_types; bet_type++) {
+                        if (stakes[bet_type] > 0) {
+                            printf(" %u:%lld", bet_type, (long long) stakes[bet_type]);
+                        }
+                    }
+                    printf("\n");
+                }
+                failed++;
+            } else if (bound == brute) {
+                matched++;
+            }
+        };
+
+        for (uint8_t bet_type = 0; bet_type < stake_types; bet_type++) {
+            std::vector<int64_t> stakes(stake_types, 0);
+            stakes[bet_type] = RISK_CHECK_UNIT;
+            check(stakes);
+        }
+
+        uint64_t seed = 0x2545F4914F6CDD1Dull;
+        auto next = [&]() {
+            seed ^= seed << 13;
+            seed ^= seed >> 7;
+            seed ^= seed << 17;
+            return seed;
+        };
+        for (uint32_t set = 0; set < RISK_CHECK_STAKE_SETS; set++) {
+            std::vector<int64_t> stakes(stake_types, 0);
+            uint64_t bets = next() % (RISK_CHECK_MAX_BETS + 1);
+            for (uint64_t i = 0; i < bets; i++) {
+                stakes[next() % stake_types] += (int64_t) (next() % RISK_CHECK_MAX_STAKE) + 1;
+            }
+            check(stakes);
+        }
+
+        uint32_t total = stake_types + RISK_CHECK_STAKE_SETS;
+        printf("%s: %u stake sets, %u %s the brute force, %u exact\n", game, total, failed,
+               exact ? "differ from" : "below", matched);
+        return failed == 0;
+    }
+}
+}
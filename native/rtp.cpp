@@ -0,0 +1,164 @@
+#include <dlfcn.h>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rtp.hpp"
+
+/**
+ * Monte Carlo return-to-player simulator. Every game module plays rounds through the contract's own result code and
+ * random generator; the rounds are cut into fixed size jobs, job j runs on random stream j, and the threads pull jobs
+ * until all are done. Totals are integer sums, so a run gives the same numbers for any thread count.
+ * With -x, games that can enumerate their outcome space report the exact figures instead.
+ *
+ * usage: native_rtp [-n rounds] [-t threads] [-s seed] [-j rounds per job] [-d module dir] [-x] [game ...]
+ */
+using namespace godapp::native;
+
+#define DEFAULT_ROUNDS      10000000
+#define DEFAULT_JOB_ROUNDS  65536
+#define Z_95                1.959964
+
+static const char* ALL_GAMES[] = {
+    "baccarat", "cbaccarat", "roulette", "quick3", "redblack", "bullfight", "scratch", "slots", "blackjack"
+};
+
+struct options {
+    uint64_t rounds = DEFAULT_ROUNDS;
+    uint64_t job_rounds = DEFAULT_JOB_ROUNDS;
+    uint64_t seed = 0x6f6e636861696e31ull;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    bool exact = false;
+    std::string module_dir = NATIVE_CONTRACT_DIR;
+    std::vector<std::string> games;
+};
+
+static const rtp_game* load_game(const std::string& module_dir, const std::string& game) {
+    std::string path = module_dir + "/rtp_" + game + ".so";
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (handle == nullptr) {
+        throw std::runtime_error("cannot load " + path + ": " + dlerror());
+    }
+    auto entry = reinterpret_cast<rtp_entry>(dlsym(handle, RTP_ENTRY_POINT));
+    if (entry == nullptr) {
+        throw std::runtime_error(path + " does not export " RTP_ENTRY_POINT);
+    }
+    return entry();
+}
+
+/**
+ * Run all jobs of one game on the given number of threads, returns the merged tallies per bet type
+ */
+static std::vector<rtp_tally> simulate(const rtp_game& game, const options& opts) {
+    uint64_t jobs = (opts.rounds + opts.job_rounds - 1) / opts.job_rounds;
+    std::atomic<uint64_t> next_job(0);
+    std::vector<std::vector<rtp_tally>> partials(opts.threads, std::vector<rtp_tally>(game.bet_count, rtp_tally()));
+
+    std::vector<std::thread> workers;
+    for (uint32_t t = 0; t < opts.threads; t++) {
+        workers.emplace_back([&, t]() {
+            std::vector<rtp_tally>& tallies = partials[t];
+            for (uint64_t job = next_job++; job < jobs; job = next_job++) {
+                uint64_t rounds = std::min(opts.job_rounds, opts.rounds - job * opts.job_rounds);
+                game.simulate(opts.seed, job, rounds, tallies.data());
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    std::vector<rtp_tally> totals(game.bet_count, rtp_tally());
+    for (const auto& tallies : partials) {
+        for (uint32_t i = 0; i < game.bet_count; i++) {
+            totals[i].merge(tallies[i]);
+        }
+    }
+    return totals;
+}
+
+/**
+ * Enumerate the outcome space of one game, the rounds of the tallies are the number of equally likely deals
+ */
+static std::vector<rtp_tally> enumerate(const rtp_game& game) {
+    std::vector<rtp_tally> totals(game.bet_count, rtp_tally());
+    game.exact(totals.data());
+    return totals;
+}
+
+static void report(const rtp_game& game, const std::vector<rtp_tally>& totals, double seconds, bool exact) {
+    if (exact) {
+        printf("%s: exact over %llu deals in %.1fs\n", game.name, (unsigned long long) totals[0].rounds, seconds);
+    } else {
+        printf("%s: %llu rounds in %.1fs, %.0f rounds/s\n", game.name, (unsigned long long) totals[0].rounds,
+               seconds, totals[0].rounds / seconds);
+    }
+    printf("  %-16s %10s %10s %10s %10s %10s\n", "bet", "rtp %", "95% ci", "std dev", "hit %", "win %");
+    for (uint32_t i = 0; i < game.bet_count; i++) {
+        const rtp_tally& tally = totals[i];
+        double rounds = (double) tally.rounds;
+        double mean = (double) tally.payout / rounds / RTP_UNIT;
+        double mean_square = (double) tally.payout_squared / rounds / ((double) RTP_UNIT * RTP_UNIT);
+        double variance = std::max(0.0, mean_square - mean * mean);
+        double ci = exact ? 0 : Z_95 * std::sqrt(variance / rounds);
+        printf("  %-16s %10.4f %10.4f %10.4f %10.4f %10.4f\n", game.bet_labels[i], mean * 100, ci * 100,
+               std::sqrt(variance), tally.hits * 100 / rounds, tally.wins * 100 / rounds);
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    options opts;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            opts.rounds = strtoull(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            opts.threads = (uint32_t) std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            opts.seed = strtoull(argv[++i], nullptr, 0);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            opts.job_rounds = std::max(1ull, strtoull(argv[++i], nullptr, 10));
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            opts.module_dir = argv[++i];
+        } else if (strcmp(argv[i], "-x") == 0) {
+            opts.exact = true;
+        } else {
+            opts.games.push_back(argv[i]);
+        }
+    }
+    if (opts.games.empty()) {
+        opts.games.assign(std::begin(ALL_GAMES), std::end(ALL_GAMES));
+    }
+    if (opts.rounds == 0) {
+        fprintf(stderr, "error: nothing to simulate\n");
+        return 1;
+    }
+
+    printf("seed 0x%llx, %u threads, %llu rounds per job\n\n", (unsigned long long) opts.seed, opts.threads,
+           (unsigned long long) opts.job_rounds);
+    try {
+        for (const auto& name : opts.games) {
+            const rtp_game* game = load_game(opts.module_dir, name);
+            if (opts.exact && game->exact == nullptr) {
+                printf("%s: no exact enumeration, skipped\n\n", game->name);
+                continue;
+            }
+            auto start = std::chrono::steady_clock::now();
+            std::vector<rtp_tally> totals = opts.exact ? enumerate(*game) : simulate(*game, opts);
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            report(*game, totals, elapsed.count(), opts.exact);
+        }
+    } catch (const std::exception& e) {
+        fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
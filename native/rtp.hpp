@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Interface between native_rtp and the per-game simulation modules (rtp_<game>.so). Every module compiles one game
+ * contract together with an adapter that plays rounds through the contract's own result code and exports
+ * rtp_game_info().
+ */
+#define RTP_UNIT            10000       // every simulated bet is 1.0000 EOS
+#define RTP_ENTRY_POINT     "rtp_game_info"
+
+namespace godapp {
+namespace native {
+    /**
+     * Totals of one bet type, all amounts are in the smallest unit of a RTP_UNIT bet
+     */
+    struct rtp_tally {
+        uint64_t rounds;
+        uint64_t hits;                      // rounds paying anything back
+        uint64_t wins;                      // rounds paying more than the bet
+        __int128 payout;
+        unsigned __int128 payout_squared;
+
+        /**
+         * Add a result that happens in weight of the rounds, exact enumerations pass the number of deals it covers
+         */
+        void add(int64_t amount, uint64_t weight = 1) {
+            rounds += weight;
+            hits += amount > 0 ? weight : 0;
+            wins += amount > RTP_UNIT ? weight : 0;
+            payout += (__int128) amount * weight;
+            payout_squared += (unsigned __int128) ((__int128) amount * amount) * weight;
+        }
+
+        void merge(const rtp_tally& other) {
+            rounds += other.rounds;
+            hits += other.hits;
+            wins += other.wins;
+            payout += other.payout;
+            payout_squared += other.payout_squared;
+        }
+    };
+
+    struct rtp_game {
+        const char* name;
+        uint32_t bet_count;
+        const char* const* bet_labels;
+
+        /**
+         * Play rounds on their own random stream and add the results to tallies[bet_count]. The stream is derived
+         * from (seed, stream) only, so a job gives the same totals whichever thread runs it.
+         */
+        void (*simulate)(uint64_t seed, uint64_t stream, uint64_t rounds, rtp_tally* tallies);
+
+        /**
+         * Optional, enumerate every outcome of a round with its exact weight into tallies[bet_count]. Every bet type
+         * gets the same total weight, the rounds of a tally are then the size of the outcome space.
+         */
+        void (*exact)(rtp_tally* tallies);
+    };
+
+    typedef const rtp_game* (*rtp_entry)();
+}
+}
@@ -0,0 +1,120 @@
+#include "../baccarat/baccarat.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"banker", "player", "tie", "dragon 7", "panda 8"};
+    static const std::vector<uint8_t> BET_TYPES = {
+        BET_BANKER_WIN, BET_PLAYER_WIN, BET_TIE, BET_DRAGON, BET_PANDA
+    };
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<baccarat_result, baccarat::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    /**
+     * The shoe compressed to the number of cards left per baccarat point, draw_cards only looks at card points
+     */
+    struct point_shoe {
+        uint64_t counts[10] = {0};
+        uint64_t left = 0;
+
+        point_shoe() {
+            for (card_t card = 0; card < NUM_CARDS; card++) {
+                counts[card_point(card)]++;
+                left++;
+            }
+        }
+
+        // number of cards that draw the point, the card is taken out of the shoe. Every point has at least 32 cards
+        // in the shoe, more than a deal can take
+        uint64_t take(uint8_t point) {
+            left--;
+            return counts[point]--;
+        }
+
+        void put_back(uint8_t point) {
+            left++;
+            counts[point]++;
+        }
+
+        // ordered ways to deal the unused cards of a six card deal, so every deal has the same denominator
+        uint64_t pad(uint8_t dealt) const {
+            uint64_t ways = 1;
+            for (uint8_t i = dealt; i < 6; i++) {
+                ways *= left - (i - dealt);
+            }
+            return ways;
+        }
+    };
+
+    /**
+     * Exact weight of every baccarat_result over all ordered six card deals of the shoe, following draw_cards
+     */
+    static void exact(rtp_tally* tallies) {
+        point_shoe shoe;
+        uint64_t weights[5] = {0};
+
+        auto settle = [&](uint8_t banker_point, size_t banker_count, uint8_t player_point, size_t player_count,
+                          uint64_t weight) {
+            uint8_t result = baccarat_result::get_result(banker_point, banker_count, player_point, player_count);
+            weights[result - 1] += weight * shoe.pad((uint8_t) (banker_count + player_count));
+        };
+
+        for (uint8_t b1 = 0; b1 < 10; b1++) {
+            uint64_t w1 = shoe.take(b1);
+            for (uint8_t p1 = 0; p1 < 10; p1++) {
+                uint64_t w2 = w1 * shoe.take(p1);
+                for (uint8_t b2 = 0; b2 < 10; b2++) {
+                    uint64_t w3 = w2 * shoe.take(b2);
+                    for (uint8_t p2 = 0; p2 < 10; p2++) {
+                        uint64_t w4 = w3 * shoe.take(p2);
+                        uint8_t banker_point = (b1 + b2) % 10;
+                        uint8_t player_point = (p1 + p2) % 10;
+
+                        if (banker_point >= 8 || player_point >= 8) {
+                            settle(banker_point, 2, player_point, 2, w4);
+                        } else if (player_point < 6) {
+                            for (uint8_t p3 = 0; p3 < 10; p3++) {
+                                uint64_t w5 = w4 * shoe.take(p3);
+                                uint8_t player_final = (player_point + p3) % 10;
+                                if (banker_draw_third_card(banker_point, p3)) {
+                                    for (uint8_t b3 = 0; b3 < 10; b3++) {
+                                        uint64_t w6 = w5 * shoe.take(b3);
+                                        settle((banker_point + b3) % 10, 3, player_final, 3, w6);
+                                        shoe.put_back(b3);
+                                    }
+                                } else {
+                                    settle(banker_point, 2, player_final, 3, w5);
+                                }
+                                shoe.put_back(p3);
+                            }
+                        } else if (banker_point < 6) {
+                            for (uint8_t b3 = 0; b3 < 10; b3++) {
+                                uint64_t w5 = w4 * shoe.take(b3);
+                                settle((banker_point + b3) % 10, 3, player_point, 2, w5);
+                                shoe.put_back(b3);
+                            }
+                        } else {
+                            settle(banker_point, 2, player_point, 2, w4);
+                        }
+                        shoe.put_back(p2);
+                    }
+                    shoe.put_back(b2);
+                }
+                shoe.put_back(p1);
+            }
+            shoe.put_back(b1);
+        }
+
+        for (size_t i = 0; i < BET_TYPES.size(); i++) {
+            for (uint8_t result = 0; result < 5; result++) {
+                int64_t payout = RTP_UNIT * (int64_t) baccarat_result::PAYOUT_MATRIX[result][BET_TYPES[i] - 1];
+                tallies[i].add(payout, weights[result]);
+            }
+        }
+    }
+
+    DEFINE_RTP_GAME_EXACT(baccarat, LABELS, simulate_round, exact)
+}
@@ -0,0 +1,32 @@
+#include "../blackjack/blackjack.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"hit below 17"};
+
+    /**
+     * Deal as playeraction does for a new game, hit until the hand reaches 17 and close with the contract's doClose
+     */
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        blackjack::game_item gm;
+        gm.bet = asset(RTP_UNIT, EOS_SYMBOL);
+        gm.insured = false;
+        gm.result = 0;
+        gm.status = GAME_STATUS_ACTIVE;
+
+        gm.banker_cards.push_back(random_card(random_gen));
+        gm.player_cards.push_back(random_card(random_gen));
+        gm.player_cards.push_back(random_card(random_gen));
+
+        while (cal_points(gm.player_cards) < BANKER_STAND_POINT) {
+            gm.player_cards.push_back(random_card(random_gen));
+        }
+        gm.status = GAME_STATUS_STOOD;
+
+        tallies[0].add(doClose(gm, random_gen).amount);
+    }
+
+    DEFINE_RTP_GAME(blackjack, LABELS, simulate_round)
+}
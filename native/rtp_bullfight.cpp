@@ -0,0 +1,15 @@
+#include "../bullfight/bullfight.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"player 1", "player 2", "player 3", "player 4"};
+    static const std::vector<uint8_t> BET_TYPES = {1, 2, 3, 4};
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<bullfight_result, bullfight::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    DEFINE_RTP_GAME(bullfight, LABELS, simulate_round)
+}
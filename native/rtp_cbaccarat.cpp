@@ -0,0 +1,17 @@
+#include "../cbaccarat/cbaccarat.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"banker", "player", "tie", "banker pair", "player pair"};
+    static const std::vector<uint8_t> BET_TYPES = {
+        BET_BANKER_WIN, BET_PLAYER_WIN, BET_TIE, BET_BANKER_PAIR, BET_PLAYER_PAIR
+    };
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<cbaccarat_result, cbaccarat::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    DEFINE_RTP_GAME(cbaccarat, LABELS, simulate_round)
+}
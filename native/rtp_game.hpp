@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+
+#include "rtp.hpp"
+
+/**
+ * Helpers for the simulation adapters, included after the game's contract source so the result classes and
+ * resolve functions are in scope.
+ */
+namespace godapp {
+namespace native {
+    /**
+     * Independent stream of the contract's own random generator, seeded with sha256(seed, stream)
+     */
+    inline random rtp_stream(uint64_t seed, uint64_t stream) {
+        uint64_t words[2] = {seed, stream};
+        capi_checksum256 digest;
+        ::sha256(reinterpret_cast<const char*>(words), sizeof(words), &digest);
+        return random(digest);
+    }
+
+    /**
+     * Resolve one round of a round based game and settle one bet of every type against it
+     */
+    template<typename Result, typename Bet>
+    void rtp_round(random& random_gen, const std::vector<uint8_t>& bet_types, rtp_tally* tallies) {
+        Result result(random_gen);
+        Bet bet_item;
+        bet_item.bet = eosio::asset(RTP_UNIT, EOS_SYMBOL);
+        for (size_t i = 0; i < bet_types.size(); i++) {
+            bet_item.bet_type = bet_types[i];
+            tallies[i].add(result.get_payout(bet_item).amount);
+        }
+    }
+}
+}
+
+/**
+ * Export a game to native_rtp. SIMULATE_ROUND(random&, rtp_tally*) plays one round and adds one result to every
+ * bet type in LABELS, EXACT(rtp_tally*) enumerates the outcome space if the game has one small enough.
+ */
+#define DEFINE_RTP_GAME_EXACT(NAME, LABELS, SIMULATE_ROUND, EXACT) \
+    static void rtp_simulate(uint64_t seed, uint64_t stream, uint64_t rounds, godapp::native::rtp_tally* tallies) { \
+        godapp::random random_gen = godapp::native::rtp_stream(seed, stream); \
+        for (uint64_t i = 0; i < rounds; i++) { \
+            SIMULATE_ROUND(random_gen, tallies); \
+        } \
+    } \
+    \
+    extern "C" const godapp::native::rtp_game* rtp_game_info() { \
+        static const godapp::native::rtp_game game = { \
+            #NAME, (uint32_t) (sizeof(LABELS) / sizeof(LABELS[0])), LABELS, rtp_simulate, EXACT \
+        }; \
+        return &game; \
+    }
+
+#define DEFINE_RTP_GAME(NAME, LABELS, SIMULATE_ROUND) DEFINE_RTP_GAME_EXACT(NAME, LABELS, SIMULATE_ROUND, nullptr)
@@ -0,0 +1,22 @@
+#include "../quick3/quick3.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {
+        "sum 3", "sum 4", "sum 5", "sum 6", "sum 7", "sum 8", "sum 9", "sum 10", "sum 11", "sum 12", "sum 13",
+        "sum 14", "sum 15", "sum 16", "sum 17", "sum 18", "large", "small", "odd", "even", "pair", "straight",
+        "three of a kind"
+    };
+    static const std::vector<uint8_t> BET_TYPES = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18,
+        BET_LARGE, BET_SMALL, BET_ODD, BET_EVEN, BET_PAIR, BET_STRAIGHT, BET_THREE_OF_A_KIND
+    };
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<quick3_result, quick3::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    DEFINE_RTP_GAME(quick3, LABELS, simulate_round)
+}
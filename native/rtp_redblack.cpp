@@ -0,0 +1,102 @@
+#include "../redblack/redblack.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"red", "black", "lucky strike"};
+    static const std::vector<uint8_t> BET_TYPES = {BET_RED_WIN, BET_BLACK_WIN, BET_LUCKY_STRIKE};
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<redblack_result, redblack::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    #define HAND_TYPE_COUNT         (HAND_THREE_OF_A_KIND + 1)
+
+    /**
+     * A three card hand evaluated once, hands with the same strength tie and a higher strength wins
+     */
+    struct evaluated_hand {
+        uint64_t mask;
+        vector<uint8_t> points;
+        uint8_t type;
+        uint32_t strength;
+    };
+
+    static vector<evaluated_hand> evaluate_hands() {
+        vector<evaluated_hand> hands;
+        for (card_t a = 0; a < NUM_CARDS; a++) {
+            for (card_t b = a + 1; b < NUM_CARDS; b++) {
+                for (card_t c = b + 1; c < NUM_CARDS; c++) {
+                    vector<card_t> cards = {a, b, c};
+                    evaluated_hand hand;
+                    hand.mask = (1ull << a) | (1ull << b) | (1ull << c);
+                    hand.points = preprocess_hand(cards);
+                    hand.type = get_hand_type(hand.points, is_same_suit(cards));
+                    hands.push_back(hand);
+                }
+            }
+        }
+
+        // the same comparison as redblack_result, red is the weaker hand when black wins
+        auto weaker = [](const evaluated_hand& red, const evaluated_hand& black) {
+            uint8_t result = compare_side(red.type, black.type);
+            if (result == 0) {
+                result = compare_same_type(red.type, red.points, black.points);
+            }
+            return result == BET_BLACK_WIN;
+        };
+        sort(hands.begin(), hands.end(), weaker);
+
+        uint32_t strength = 0;
+        for (size_t i = 0; i < hands.size(); i++) {
+            if (i > 0 && weaker(hands[i - 1], hands[i])) {
+                strength++;
+            }
+            hands[i].strength = strength;
+        }
+        return hands;
+    }
+
+    /**
+     * Exact weight of every (winner, best hand type) over all pairs of disjoint hands. The payouts only depend on
+     * the unordered hands, so each pair stands for the 3! * 3! orders add_cards can deal it in.
+     */
+    static void exact(rtp_tally* tallies) {
+        vector<evaluated_hand> hands = evaluate_hands();
+        uint64_t weights[3][HAND_TYPE_COUNT] = {{0}};
+
+        for (size_t i = 0; i < hands.size(); i++) {
+            const evaluated_hand& first = hands[i];
+            for (size_t j = i + 1; j < hands.size(); j++) {
+                const evaluated_hand& second = hands[j];
+                if ((first.mask & second.mask) != 0) {
+                    continue;
+                }
+                uint8_t best_type = max(first.type, second.type);
+                // count the pair once with each hand on the red side
+                uint8_t result = first.strength > second.strength ? BET_RED_WIN
+                        : (first.strength < second.strength ? BET_BLACK_WIN : 0);
+                weights[result][best_type]++;
+                weights[result == 0 ? 0 : (BET_RED_WIN + BET_BLACK_WIN - result)][best_type]++;
+            }
+        }
+
+        const asset bet(RTP_UNIT, EOS_SYMBOL);
+        for (size_t i = 0; i < BET_TYPES.size(); i++) {
+            for (uint8_t result = 0; result < 3; result++) {
+                for (uint8_t best_type = 0; best_type < HAND_TYPE_COUNT; best_type++) {
+                    asset payout = bet * 0;
+                    if (BET_TYPES[i] == BET_LUCKY_STRIKE) {
+                        payout = bet * get_lucky_strike_rate(best_type);
+                    } else if (BET_TYPES[i] == result) {
+                        payout = bet * RATE_WIN / 100;
+                    }
+                    tallies[i].add(payout.amount, weights[result][best_type]);
+                }
+            }
+        }
+    }
+
+    DEFINE_RTP_GAME_EXACT(redblack, LABELS, simulate_round, exact)
+}
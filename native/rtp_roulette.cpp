@@ -0,0 +1,22 @@
+#include "../roulette/roulette.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    // a single number is the same bet whichever number it is, one straight up bet stands for all of them
+    static const char* LABELS[] = {
+        "zero", "number 17", "even", "odd", "large", "small", "front", "mid", "back",
+        "line 1", "line 2", "line 3", "red", "black"
+    };
+    static const std::vector<uint8_t> BET_TYPES = {
+        BET_NUMBER_ZERO, 18, BET_EVEN, BET_ODD, BET_LARGE, BET_SMALL, BET_FRONT, BET_MID, BET_BACK,
+        BET_LINE_ONE, BET_LINE_TWO, BET_LINE_THREE, BET_RED, BET_BLACK
+    };
+
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        native::rtp_round<roulette_result, roulette::bet>(random_gen, BET_TYPES, tallies);
+    }
+
+    DEFINE_RTP_GAME(roulette, LABELS, simulate_round)
+}
@@ -0,0 +1,29 @@
+#include "../scratch/scratch.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"card 1", "card 2", "card 3", "card 4"};
+
+    typedef uint64_t (*resolve_card)(random&, std::vector<scratch::line_result>&, const asset&, asset&);
+    static const resolve_card CARDS[] = {
+        resolveCard1, resolveCard2, resolveCard3, resolveCard4
+    };
+
+    /**
+     * Scratch one card of every type, each from its own draws of the stream
+     */
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        const asset price(RTP_UNIT, EOS_SYMBOL);
+        std::vector<scratch::line_result> result_detail;
+        for (int i = 0; i < CARD_TYPE_COUNT; i++) {
+            asset reward(0, price.symbol);
+            result_detail.clear();
+            CARDS[i](random_gen, result_detail, price, reward);
+            tallies[i].add(reward.amount);
+        }
+    }
+
+    DEFINE_RTP_GAME(scratch, LABELS, simulate_round)
+}
@@ -0,0 +1,25 @@
+#include "../slots/slots.cpp"
+#include "rtp_game.hpp"
+
+namespace godapp {
+    using native::rtp_tally;
+
+    static const char* LABELS[] = {"spin"};
+
+    /**
+     * Same lookup as slots::reveal against the rewards[] table
+     */
+    static void simulate_round(random& random_gen, rtp_tally* tallies) {
+        uint16_t result = 0;
+        uint64_t value = random_gen.generator(10000);
+        for (int i=0; i < REWARD_COUNT; i++) {
+            if (value < rewards[i].winNumber) {
+                result = rewards[i].result;
+                break;
+            }
+        }
+        tallies[0].add((int64_t) RTP_UNIT * result);
+    }
+
+    DEFINE_RTP_GAME(slots, LABELS, simulate_round)
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace godapp {
+namespace native {
+    /**
+     * Plain FIPS 180-4 SHA-256, backing the sha256 / assert_sha256 intrinsics
+     * @param data Data to be hashed
+     * @param length Length of the data in bytes
+     * @param digest Output buffer of 32 bytes
+     */
+    void sha256(const void* data, size_t length, uint8_t digest[32]);
+}
+}
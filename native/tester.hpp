@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <eosiolib/eosio.hpp>
+#include <eosiolib/asset.hpp>
+
+#include "chain.hpp"
+#include "../common/constants.hpp"
+
+namespace godapp {
+namespace native {
+    using eosio::asset;
+    using eosio::name;
+    using eosio::symbol;
+
+    /**
+     * Thin wrapper over the chain emulator that packs action arguments with the eosiolib serializer, so drivers can
+     * push actions the same way cleos would
+     */
+    class tester {
+    public:
+        explicit tester(const std::string& contract_dir): _contract_dir(contract_dir), _chain(chain::instance()) {}
+
+        chain& get_chain() {
+            return _chain;
+        }
+
+        const chain& get_chain() const {
+            return _chain;
+        }
+
+        /**
+         * Load a contract module built by this project into an account
+         * @param account Account to deploy to
+         * @param contract Name of the contract, e.g. "dice"
+         */
+        void deploy(name account, const std::string& contract) {
+            _chain.load_contract(account.value, _contract_dir + "/" + contract + ".so");
+        }
+
+        void create_account(name account) {
+            _chain.create_account(account.value);
+        }
+
+        void issue(name account, asset quantity) {
+            _chain.issue(account.value, quantity.amount, quantity.symbol.raw());
+        }
+
+        asset get_balance(name account, symbol sym = EOS_SYMBOL) const {
+            return asset(_chain.get_balance(account.value, sym.raw()), sym);
+        }
+
+        /**
+         * Build an action authorized by actor@active
+         */
+        template<typename... Args>
+        static action_data make_action(name actor, name contract, name action, Args&&... args) {
+            action_data act;
+            act.account = contract.value;
+            act.name = action.value;
+            act.authorization.push_back({actor.value, name("active").value});
+            act.data = eosio::pack(std::make_tuple(std::forward<Args>(args)...));
+            return act;
+        }
+
+        template<typename... Args>
+        void push(name actor, name contract, name action, Args&&... args) {
+            _chain.push_action(make_action(actor, contract, action, std::forward<Args>(args)...));
+        }
+
+        void transfer(name from, name to, asset quantity, const std::string& memo) {
+            push(from, EOS_TOKEN_CONTRACT, name("transfer"), from, to, quantity, memo);
+        }
+
+        /**
+         * Advance the chain and execute every deferred transaction that became due
+         * @param seconds Time to advance
+         */
+        size_t produce_block(uint32_t seconds = 0) {
+            _chain.produce_block(seconds);
+            return _chain.run_deferred();
+        }
+
+    private:
+        std::string _contract_dir;
+        chain& _chain;
+    };
+}
+}
@@ -5,20 +5,6 @@
 #include "../common/eosio.token.hpp"
 #include "../house/house.hpp"
 
-#define G_ID_START                  101
-#define G_ID_RESULT_ID              101
-#define G_ID_GAME_ID                102
-#define G_ID_BET_ID                 103
-#define G_ID_HISTORY_ID             104
-#define G_ID_END                    104
-
-#define GAME_LENGTH                 60
-#define GAME_RESOLVE_TIME           12
-
-#define RESULT_SIZE                 100
-#define HISTORY_SIZE                50
-
-
 #define BET_NUMBER_THREE            3
 #define BET_LARGE                   19
 #define BET_SMALL                   20
@@ -31,7 +17,14 @@
 
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(quick3)
+    struct quick3_config {
+        static constexpr uint32_t GAME_LENGTH = 60;
+        static constexpr uint64_t RESULT_SIZE = 100;
+        static constexpr uint64_t HISTORY_SIZE = 50;
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] quick3 win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] quick3 lose!";
+    };
 
     class quick3_result {
     public:
@@ -43,6 +36,8 @@ namespace godapp {
         bool threeOfAKind = true;
         bool pair = false;
         bool straight = true;
+        static constexpr uint8_t BET_TYPES = BET_THREE_OF_A_KIND + 1;
+        payout_table<BET_TYPES, 100> payouts;
 
         static constexpr uint64_t SUM_PAY_RATE_ARRAY[19] = {
             0, 0, 0, 19008, 6336, 3168, 1901, 1267, 904, 760,
@@ -80,9 +75,44 @@ namespace godapp {
                 }
                 last = value;
             }
+
+            payouts.fill<quick3::bet>([&](const quick3::bet& bet_item) {
+                return payout(sum, pair, straight, threeOfAKind, bet_item);
+            });
         }
 
         asset get_payout(const quick3::bet& bet_item) {
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        /**
+         * Worst case payout of a round's stakes by bet type. The sum bets are exact for each sum, the pair, straight
+         * and three of a kind bets are bounded over all rolls: a roll is either a straight or may have a pair, which
+         * may be three of a kind.
+         */
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            auto stake_payout = [&](uint8_t sum, bool pair, bool straight, bool three_of_a_kind, uint8_t bet_type) {
+                if (stakes[bet_type] == 0) {
+                    return (int64_t) 0;
+                }
+                quick3::bet bet_item{asset(stakes[bet_type], EOS_SYMBOL), bet_type};
+                return payout(sum, pair, straight, three_of_a_kind, bet_item).amount;
+            };
+
+            int64_t worst = 0;
+            for (uint8_t sum = 3; sum <= 18; sum++) {
+                int64_t total = stake_payout(sum, false, false, false, sum);
+                for (uint8_t bet_type : {BET_LARGE, BET_SMALL, BET_ODD, BET_EVEN}) {
+                    total += stake_payout(sum, false, false, false, bet_type);
+                }
+                worst = max(worst, total);
+            }
+            int64_t pairs = stake_payout(0, true, false, true, BET_PAIR)
+                    + stake_payout(0, true, false, true, BET_THREE_OF_A_KIND);
+            return worst + max(pairs, stake_payout(0, false, true, false, BET_STRAIGHT));
+        }
+
+        static asset payout(uint8_t sum, bool pair, bool straight, bool threeOfAKind, const quick3::bet& bet_item) {
             uint8_t bet_type = bet_item.bet_type;
             uint64_t pay_rate = 0;
             if (bet_type <= 18) {
@@ -134,5 +164,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(quick3, quick3, quick3_result, 1)
+    DEFINE_ROUND_GAME(quick3)
 };
\ No newline at end of file
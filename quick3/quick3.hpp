@@ -14,14 +14,19 @@ namespace godapp {
     using namespace eosio;
     using namespace std;
 
-    CONTRACT quick3: public contract {
+    class quick3_result;
+    struct quick3_config;
+
+    CONTRACT quick3: public round_game<quick3, quick3_result, quick3_config> {
     public:
         DEFINE_GLOBAL_TABLE
+        DEFINE_COUNTERS_TABLE
         DEFINE_GAMES_TABLE(std::vector<uint8_t> result;)
         DEFINE_BETS_TABLE
+        DEFINE_ROUND_RISK_TABLE
+        DEFINE_SETTLEMENT_TABLE
         DEFINE_RESULTS_TABLE
         DEFINE_HISTORY_TABLE
-        DEFINE_BET_AMOUNT_TABLE
         DEFINE_RANDOM_KEY_TABLE
 
         ACTION receipt(uint64_t game_id, capi_checksum256 seed, vector<uint8_t> result);
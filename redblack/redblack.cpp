@@ -5,19 +5,6 @@
 #include "../common/eosio.token.hpp"
 #include "../house/house.hpp"
 
-#define G_ID_START                  101
-#define G_ID_RESULT_ID              101
-#define G_ID_GAME_ID                102
-#define G_ID_BET_ID                 103
-#define G_ID_HISTORY_ID             104
-#define G_ID_END                    104
-
-#define GAME_LENGTH                 40
-#define GAME_RESOLVE_TIME           15
-
-#define RESULT_SIZE                 60
-#define HISTORY_SIZE                40
-
 #define NUM_CARDS                   52
 
 #define BET_RED_WIN                 1
@@ -42,7 +29,14 @@
 
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(redblack)
+    struct redblack_config {
+        static constexpr uint32_t GAME_LENGTH = 40;
+        static constexpr uint64_t RESULT_SIZE = 60;
+        static constexpr uint64_t HISTORY_SIZE = 40;
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] Red Vs Blue win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] Red Vs Blue lose!";
+    };
 
     uint8_t get_lucky_strike_rate(uint8_t bet_type) {
         switch (bet_type) {
@@ -165,11 +159,13 @@ namespace godapp {
         uint8_t game_result, result;
         uint8_t lucky_rate;
         uint8_t roundResult;
+        static constexpr uint8_t BET_TYPES = BET_LUCKY_STRIKE + 1;
+        payout_table<BET_TYPES, 100> payouts;
 
         redblack_result(random& random_gen) {
-            vector<card_t> cards;
-            add_cards(random_gen, red_cards, cards, 3, NUM_CARDS);
-            add_cards(random_gen, black_cards, cards, 3, NUM_CARDS);
+            card_deck deck(NUM_CARDS);
+            deck.add_cards(random_gen, red_cards, 3);
+            deck.add_cards(random_gen, black_cards, 3);
 
             red_points = preprocess_hand(red_cards);
             black_points = preprocess_hand(black_cards);
@@ -184,9 +180,28 @@ namespace godapp {
             lucky_rate = get_lucky_strike_rate(max(red_type, black_type));
             result = (lucky_rate > 0) ? (game_result | BET_LUCKY_STRIKE) : game_result;
             roundResult = result;
+            payouts.fill<redblack::bet>([&](const redblack::bet &bet_item) {
+                return payout(game_result, lucky_rate, bet_item);
+            });
         }
 
         asset get_payout(const redblack::bet &bet_item) {
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        // red or black wins, a tie pays neither side. Three of a kind can come with either winner, so the lucky
+        // strike is counted at its top rate in both
+        static constexpr size_t OUTCOMES = 2;
+
+        static asset outcome_payout(size_t outcome, const redblack::bet &bet_item) {
+            return payout(outcome == 0 ? BET_RED_WIN : BET_BLACK_WIN, RATE_THREE_OF_A_KIND, bet_item);
+        }
+
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            return outcome_worst_payout<redblack_result, redblack::bet>(stakes);
+        }
+
+        static asset payout(uint8_t game_result, uint8_t lucky_rate, const redblack::bet &bet_item) {
             asset bet = bet_item.bet;
             uint8_t bet_type = bet_item.bet_type;
 
@@ -228,5 +243,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(redblack, Red Vs Blue, redblack_result, 1)
+    DEFINE_ROUND_GAME(redblack)
 };
\ No newline at end of file
@@ -16,14 +16,19 @@ namespace godapp {
     using namespace eosio;
     using namespace std;
 
-    CONTRACT redblack: public contract {
+    class redblack_result;
+    struct redblack_config;
+
+    CONTRACT redblack: public round_game<redblack, redblack_result, redblack_config> {
     public:
         DEFINE_GLOBAL_TABLE
+        DEFINE_COUNTERS_TABLE
         DEFINE_GAMES_TABLE(vector<card_t> red_cards; vector<card_t> black_cards;)
         DEFINE_BETS_TABLE
+        DEFINE_ROUND_RISK_TABLE
+        DEFINE_SETTLEMENT_TABLE
         DEFINE_RESULTS_TABLE
         DEFINE_HISTORY_TABLE
-        DEFINE_BET_AMOUNT_TABLE
         DEFINE_RANDOM_KEY_TABLE
 
         ACTION receipt(uint64_t game_id, capi_checksum256 seed, string red_cards, string blue_cards, string result,
@@ -4,19 +4,6 @@
 #include "../common/eosio.token.hpp"
 #include "../house/house.hpp"
 
-#define G_ID_START                  101
-#define G_ID_RESULT_ID              101
-#define G_ID_GAME_ID                102
-#define G_ID_BET_ID                 103
-#define G_ID_HISTORY_ID             104
-#define G_ID_END                    104
-
-#define GAME_LENGTH                 45
-#define GAME_RESOLVE_TIME           15
-
-#define RESULT_SIZE                 60
-#define HISTORY_SIZE                40
-
 #define BET_NUMBER_ZERO             1
 #define BET_NUMBER_END              37
 #define BET_EVEN                    38
@@ -34,21 +21,33 @@
 
 
 namespace godapp {
-    DEFINE_STANDARD_FUNCTIONS(roulette)
+    struct roulette_config {
+        static constexpr uint32_t GAME_LENGTH = 45;
+        static constexpr uint64_t RESULT_SIZE = 60;
+        static constexpr uint64_t HISTORY_SIZE = 40;
+        static constexpr int64_t REFERRAL_FACTOR = 1;
+        static constexpr const char* WIN_MEMO = "[Dapp365] Roulette win!";
+        static constexpr const char* LOSE_MEMO = "[Dapp365] Roulette lose!";
+    };
 
     class roulette_result {
     public:
         uint8_t result;
         uint8_t roundResult;
         bool is_red;
+        static constexpr uint8_t BET_TYPES = BET_BLACK + 1;
+        payout_table<BET_TYPES, 1> payouts;
 
         roulette_result(random& random_gen) {
             result = random_gen.generator(BET_NUMBER_END);
             roundResult = result;
             is_red = IS_RED[result];
+            payouts.fill<roulette::bet>([&](const roulette::bet& bet_item) {
+                return payout(result, bet_item);
+            });
         }
 
-        bool IS_RED[BET_NUMBER_END] = {
+        static constexpr bool IS_RED[BET_NUMBER_END] = {
             false,              // 0
             true, false, true,  // 1
             false, true, false, // 4
@@ -65,6 +64,38 @@ namespace godapp {
         };
 
         asset get_payout(const roulette::bet& bet_item) {
+            return payouts.payout(bet_item.bet, bet_item.bet_type);
+        }
+
+        /**
+         * Worst case payout of a round's stakes by bet type. A number only pays its own bet and the outside bets
+         * that contain it, so each number sums at most 13 stakes.
+         */
+        static int64_t worst_payout(const vector<int64_t>& stakes) {
+            static constexpr uint8_t OUTSIDE_BETS[] = {
+                BET_EVEN, BET_ODD, BET_LARGE, BET_SMALL, BET_FRONT, BET_MID, BET_BACK,
+                BET_LINE_ONE, BET_LINE_TWO, BET_LINE_THREE, BET_RED, BET_BLACK
+            };
+            int64_t worst = 0;
+            for (uint8_t number = 0; number < BET_NUMBER_END; number++) {
+                int64_t total = stake_payout(number, BET_NUMBER_ZERO + number, stakes);
+                for (uint8_t bet_type : OUTSIDE_BETS) {
+                    total += stake_payout(number, bet_type, stakes);
+                }
+                worst = max(worst, total);
+            }
+            return worst;
+        }
+
+        static int64_t stake_payout(uint8_t result, uint8_t bet_type, const vector<int64_t>& stakes) {
+            if (stakes[bet_type] == 0) {
+                return 0;
+            }
+            return payout(result, roulette::bet{asset(stakes[bet_type], EOS_SYMBOL), bet_type}).amount;
+        }
+
+        static asset payout(uint8_t result, const roulette::bet& bet_item) {
+            bool is_red = IS_RED[result];
             uint8_t bet_type = bet_item.bet_type;
             uint8_t pay_rate = 0;
             if (result == 0) {
@@ -129,5 +160,5 @@ namespace godapp {
         require_recipient(_self);
     }
 
-    DEFINE_REVEAL_FUNCTION(roulette, Roulette, roulette_result, 1)
+    DEFINE_ROUND_GAME(roulette)
 };
\ No newline at end of file
@@ -15,14 +15,19 @@ namespace godapp {
     using namespace eosio;
     using namespace std;
 
-    CONTRACT roulette: public contract {
+    class roulette_result;
+    struct roulette_config;
+
+    CONTRACT roulette: public round_game<roulette, roulette_result, roulette_config> {
     public:
         DEFINE_GLOBAL_TABLE
+        DEFINE_COUNTERS_TABLE
         DEFINE_GAMES_TABLE(uint8_t result;)
         DEFINE_BETS_TABLE
+        DEFINE_ROUND_RISK_TABLE
+        DEFINE_SETTLEMENT_TABLE
         DEFINE_RESULTS_TABLE
         DEFINE_HISTORY_TABLE
-        DEFINE_BET_AMOUNT_TABLE
         DEFINE_RANDOM_KEY_TABLE
 
         ACTION receipt(uint64_t game_id, capi_checksum256 seed, uint8_t result);
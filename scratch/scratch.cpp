@@ -1,5 +1,6 @@
 #include <vector>
 #include <string>
+#include <cmath>
 #include <eosiolib/eosio.hpp>
 #include <eosiolib/crypto.h>
 #include <eosiolib/time.hpp>
@@ -181,11 +182,9 @@ namespace godapp {
         }
     }
 
-    void scratch::transfer(name from, name to, asset quantity, string memo) {
-        if (!check_transfer(this, from, to, quantity, memo)) {
-            return;
-        };
+    DEFINE_ROUTED_TRANSFER(scratch)
 
+    void scratch::doBet(name from, asset quantity, const string& memo, bool routed) {
         param_reader reader(memo);
         uint8_t card_type = reader.next_param_i();
         uint64_t price = reader.next_param_i64();
@@ -196,7 +195,7 @@ namespace godapp {
         eosio_assert(price == prices[card_type], "Invalid Price");
         eosio_assert(count <= 100, "Maximum 100 cards allowed");
         eosio_assert(quantity.amount == price * count, "Invalid transfer amount");
-        transfer_to_house(_self, quantity, from, quantity.amount);
+        accept_bet(_self, routed, quantity, from, quantity.amount);
         
         doClaim(from);
         
@@ -82,6 +82,7 @@ namespace godapp {
         ACTION receipt(uint64_t card_id, name player, asset price, asset reward, capi_checksum256 seed,
             std::vector<line_result> result, name referer);
         ACTION transfer(name from, name to, asset quantity, string memo);
+        ACTION placebet(name player, asset quantity, string memo);
         ACTION play(name player, uint8_t card_type, name referer);
         ACTION claim(name player);
         ACTION secretsend(name player);
@@ -91,7 +92,8 @@ namespace godapp {
     private:
         void scratch_card(name player, uint8_t card_type, asset price, name referer);
         void doClaim(name player);
+        void doBet(name from, asset quantity, const string& memo, bool routed);
     };
 
-    EOSIO_ABI_EX(scratch, (claim)(init)(play)(reveal)(receipt)(secretsend)(setglobal)(transfer))
+    EOSIO_ABI_EX(scratch, (claim)(init)(play)(reveal)(receipt)(secretsend)(setglobal)(transfer)(placebet))
 }
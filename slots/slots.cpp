@@ -55,11 +55,9 @@ namespace godapp {
 
     DEFINE_SET_GLOBAL(slots)
 
-    void slots::transfer(name from, name to, asset quantity, string memo) {
-        if (!check_transfer(this, from, to, quantity, memo)) {
-            return;
-        };
+    DEFINE_ROUTED_TRANSFER(slots)
 
+    void slots::doBet(name from, asset quantity, const string& memo, bool routed) {
         param_reader reader(memo);
         name referer = reader.get_referer(from);
 
@@ -81,7 +79,7 @@ namespace godapp {
             game.time = time;
         });
 
-        transfer_to_house(_self, quantity, from, quantity.amount);
+        accept_bet(_self, routed, quantity, from, quantity.amount);
     }
 
     void slots::reveal(uint64_t game_id, capi_signature sig){
@@ -61,8 +61,12 @@ namespace godapp {
         ACTION pay(uint64_t card_id, name player, asset price, asset reward, capi_checksum256 seed,
             uint16_t result, name referer);
         ACTION transfer(name from, name to, asset quantity, string memo);
+        ACTION placebet(name player, asset quantity, string memo);
         slots(name receiver, name code, datastream<const char *> ds);
+
+    private:
+        void doBet(name from, asset quantity, const string& memo, bool routed);
     };
 
-    EOSIO_ABI_EX(slots, (init)(setglobal)(transfer)(reveal)(pay))
+    EOSIO_ABI_EX(slots, (init)(setglobal)(transfer)(placebet)(reveal)(pay))
 }